@@ -0,0 +1,92 @@
+//
+// Created by taylor-santos on 10/18/2026 at 13:25.
+//
+// Measures how deriving Boards from one shared root scales with the number of threads, comparing
+// deriving directly from the shared root against deriving from a per-thread Board::branch().
+//
+// Usage: portal_chess_bench_sharing [max threads] [iterations per thread]
+//
+
+#include "board.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+
+#include "coord.h"
+#include "piece.h"
+
+using namespace Chess;
+
+static std::shared_ptr<const Board>
+makeStartingBoard() {
+    std::vector<std::pair<Coord, incomplete_ptr<Piece>>> pieces;
+
+    Type back[] = {
+        Type::Rook,
+        Type::Knight,
+        Type::Bishop,
+        Type::Queen,
+        Type::King,
+        Type::Bishop,
+        Type::Knight,
+        Type::Rook};
+    for (int file = A; file <= H; file++) {
+        auto f = static_cast<File>(file);
+        pieces.emplace_back(Coord{f, _1}, std::make_unique<Piece>(back[file - 1], Color::White));
+        pieces.emplace_back(Coord{f, _2}, std::make_unique<Piece>(Type::Pawn, Color::White));
+        pieces.emplace_back(Coord{f, _7}, std::make_unique<Piece>(Type::Pawn, Color::Black));
+        pieces.emplace_back(Coord{f, _8}, std::make_unique<Piece>(back[file - 1], Color::Black));
+    }
+    return Board::make(std::move(pieces));
+}
+
+// One unit of work: derive a move and a reply from the given Board, as a search would when
+// expanding a node, and look at the squares involved.
+static bool
+expand(const std::shared_ptr<const Board> &board, int i) {
+    auto file  = static_cast<File>(i % 8 + 1);
+    auto child = board->movePiece({file, _2}, {file, _4});
+    auto reply = child->movePiece({file, _7}, {file, _5});
+    return reply->at({file, _4}).has_value() && reply->at({file, _5}).has_value();
+}
+
+static double
+run(const std::shared_ptr<const Board> &root, unsigned threadCount, long iterations, bool branch) {
+    std::vector<std::thread> threads;
+    auto                     start = std::chrono::steady_clock::now();
+    for (unsigned t = 0; t < threadCount; t++) {
+        threads.emplace_back([&root, iterations, branch] {
+            auto local = branch ? root->branch() : root;
+            int  found = 0;
+            for (long i = 0; i < iterations; i++) {
+                found += expand(local, static_cast<int>(i));
+            }
+            if (found != iterations) std::fprintf(stderr, "unexpected lookup result\n");
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return static_cast<double>(threadCount) * static_cast<double>(iterations) / elapsed.count();
+}
+
+int
+main(int argc, char **argv) {
+    unsigned maxThreads = argc > 1 ? std::stoul(argv[1]) : std::thread::hardware_concurrency();
+    long     iterations = argc > 2 ? std::stol(argv[2]) : 200000;
+    if (maxThreads == 0) maxThreads = 1;
+
+    auto root = makeStartingBoard();
+    std::printf("%8s %16s %16s\n", "threads", "shared (exp/s)", "branched (exp/s)");
+    for (unsigned threads = 1;; threads = std::min(threads * 2, maxThreads)) {
+        auto shared   = run(root, threads, iterations, false);
+        auto branched = run(root, threads, iterations, true);
+        std::printf("%8u %16.0f %16.0f\n", threads, shared, branched);
+        if (threads == maxThreads) break;
+    }
+    return 0;
+}
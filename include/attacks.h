@@ -0,0 +1,644 @@
+//
+// Created by taylor-santos on 10/18/2026 at 14:02.
+//
+
+#ifndef PORTAL_CHESS_INCLUDE_ATTACKS_H
+#define PORTAL_CHESS_INCLUDE_ATTACKS_H
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "board.h"
+#include "coord.h"
+#include "geometry.h"
+#include "piece.h"
+
+namespace Chess {
+
+// A set of squares on a standard board, with bit (rank - 1) * 8 + (file - 1) representing each
+// coordinate.
+using Bitboard = StandardGeometry::Mask;
+
+/***
+ * @param coord the coordinate to convert
+ * @returns the index of the given coordinate's bit in a Bitboard
+ */
+[[nodiscard]] int
+squareOf(Coord coord);
+
+/***
+ * @param square a Bitboard bit index in the interval [0,63]
+ * @returns the coordinate represented by the given bit index
+ */
+[[nodiscard]] Coord
+coordOf(int square);
+
+/***
+ * @param coord the coordinate to convert
+ * @returns a Bitboard containing only the given coordinate
+ */
+[[nodiscard]] Bitboard
+bitOf(Coord coord);
+
+/***
+ * The squares attacked by every piece on a board of the given Geometry, kept up to date as pieces
+ * are added, removed and moved. Squares are identified by their Geometry index.
+ *
+ * Portals follow these rules:
+ * - When exactly two portals of the same color are on the board, they are linked.
+ * - A step, either one square along a sliding piece's ray or one leap of a non-sliding piece,
+ *   that would land on a linked portal instead lands the same offset beyond its partner, then
+ *   continues from there. Steps cannot pass through two portals in a row.
+ * - Unlinked portals block movement. Portals never attack and cannot be attacked.
+ *
+ * Each piece remembers which squares its attacks passed through. When a square changes, only
+ * pieces whose attacks passed through that square, or through a portal whose link changed, are
+ * recomputed.
+ *
+ * The members are defined at the end of this header, so any Geometry can be used. Only the
+ * standard board is compiled into the library.
+ */
+template<typename G>
+class BasicAttackMap {
+public:
+    using Mask = typename G::Mask;
+
+    /***
+     * Construct a BasicAttackMap describing the given pieces.
+     * @param pieces the square and piece of every piece on the board
+     * @throws invalid_piece if two pieces share a square
+     */
+    explicit BasicAttackMap(const std::vector<std::pair<int, Piece>> &pieces);
+
+    /***
+     * Update the attacks for a piece added to the board.
+     * @param square the square the piece was added at
+     * @param piece the added piece
+     * @throws invalid_piece if a piece already exists at the given square
+     */
+    void
+    addPiece(int square, Piece piece);
+
+    /***
+     * Update the attacks for a piece removed from the board.
+     * @param square the square the piece was removed from
+     * @throws invalid_piece if no piece exists at the given square
+     */
+    void
+    removePiece(int square);
+
+    /***
+     * Update the attacks for a piece moved from one square to another.
+     * @param from the square the piece moved from
+     * @param to the square the piece moved to
+     * @throws invalid_piece if either the "from" square is unoccupied,
+     *         or if the "to" square is occupied
+     */
+    void
+    movePiece(int from, int to);
+
+    /***
+     * @param square the square to look up
+     * @returns the piece at the given square, if one exists
+     */
+    [[nodiscard]] const std::optional<Piece> &
+    at(int square) const;
+
+    /***
+     * @param square the square of an attacking piece
+     * @returns the squares attacked by the piece at the given square, or an empty Mask if that
+     * square is empty
+     */
+    [[nodiscard]] Mask
+    attacksFrom(int square) const;
+
+    /***
+     * @param square the square being attacked
+     * @param color the color of the attacking pieces
+     * @returns the squares of every piece of the given color that attacks the given square
+     */
+    [[nodiscard]] Mask
+    attackersOf(int square, Color color) const;
+
+    /***
+     * @param square the square of a defended piece
+     * @returns the squares of every piece that attacks the given square and has the same color as
+     * the piece on it, or an empty Mask if that square is empty
+     */
+    [[nodiscard]] Mask
+    defendersOf(int square) const;
+
+    /***
+     * @param square the square being attacked
+     * @param color the color of the attacking pieces
+     * @returns true if any piece of the given color attacks the given square
+     */
+    [[nodiscard]] bool
+    isAttacked(int square, Color color) const;
+
+    /***
+     * @param square the square of a portal
+     * @returns the square of the portal linked to the given one, or -1 if it is not linked
+     */
+    [[nodiscard]] int
+    portalPartner(int square) const;
+
+    /***
+     * Take one step from the given square, following the portal rules.
+     * @param from the square to step from
+     * @param step the step to take
+     * @returns the square reached, or -1 if the step leaves the board or is blocked by a portal
+     */
+    [[nodiscard]] int
+    step(int from, Step step) const;
+
+    /***
+     * @param color a piece color
+     * @returns the squares of every non-portal piece of the given color
+     */
+    [[nodiscard]] Mask
+    pieces(Color color) const;
+
+    /***
+     * @param color a piece color
+     * @returns the squares of every portal of the given color
+     */
+    [[nodiscard]] Mask
+    portals(Color color) const;
+
+protected:
+    BasicAttackMap();
+
+    void
+    place(int square, Piece piece);
+
+    void
+    rebuild();
+
+private:
+    void
+    clear(int square);
+
+    void
+    retract(int square);
+
+    [[nodiscard]] Mask
+    relink(Color color);
+
+    void
+    update(Mask changed);
+
+    void
+    recompute(int square);
+
+    [[nodiscard]] int
+    follow(int from, Step step, Mask &touched) const;
+
+    std::array<std::optional<Piece>, G::squares> pieces_;
+    std::array<Mask, 2>                          colors_;
+    std::array<Mask, 2>                          portals_;
+    std::array<int, G::squares>                  partners_;
+    std::array<Mask, G::squares>                 attacks_;
+    std::array<Mask, G::squares>                 touched_;
+    std::array<Mask, G::squares>                 attackers_;
+};
+
+/***
+ * The BasicAttackMap for a standard board, which can be built from a Board and addressed by
+ * coordinate as well as by square index.
+ */
+class AttackMap : public BasicAttackMap<StandardGeometry> {
+public:
+    /***
+     * Construct an AttackMap describing the pieces on the given Board.
+     * @param board the Board to read pieces from
+     */
+    explicit AttackMap(const Board &board);
+
+    using BasicAttackMap::addPiece;
+    using BasicAttackMap::at;
+    using BasicAttackMap::attackersOf;
+    using BasicAttackMap::attacksFrom;
+    using BasicAttackMap::defendersOf;
+    using BasicAttackMap::isAttacked;
+    using BasicAttackMap::movePiece;
+    using BasicAttackMap::portalPartner;
+    using BasicAttackMap::removePiece;
+    using BasicAttackMap::step;
+
+    /***
+     * Update the attacks for a piece added to the board.
+     * @param coord the coordinate the piece was added at
+     * @param piece the added piece
+     * @throws invalid_piece if a piece already exists at the given coordinate
+     */
+    void
+    addPiece(Coord coord, Piece piece);
+
+    /***
+     * Update the attacks for a piece removed from the board.
+     * @param coord the coordinate the piece was removed from
+     * @throws invalid_piece if no piece exists at the given coordinate
+     */
+    void
+    removePiece(Coord coord);
+
+    /***
+     * Update the attacks for a piece moved from one coordinate to another.
+     * @param from the coordinate the piece moved from
+     * @param to the coordinate the piece moved to
+     * @throws invalid_piece if either the "from" coordinate is unoccupied,
+     *         or if the "to" coordinate is occupied
+     */
+    void
+    movePiece(Coord from, Coord to);
+
+    /***
+     * @param coord the coordinate to look up
+     * @returns the piece at the given coordinate, if one exists
+     */
+    [[nodiscard]] std::optional<Piece>
+    at(Coord coord) const;
+
+    /***
+     * @param coord the coordinate of an attacking piece
+     * @returns the squares attacked by the piece at the given coordinate, or an empty Bitboard if
+     * that coordinate is empty
+     */
+    [[nodiscard]] Bitboard
+    attacksFrom(Coord coord) const;
+
+    /***
+     * @param coord the coordinate being attacked
+     * @param color the color of the attacking pieces
+     * @returns the squares of every piece of the given color that attacks the given coordinate
+     */
+    [[nodiscard]] Bitboard
+    attackersOf(Coord coord, Color color) const;
+
+    /***
+     * @param coord the coordinate of a defended piece
+     * @returns the squares of every piece that attacks the given coordinate and has the same color
+     * as the piece on it, or an empty Bitboard if that coordinate is empty
+     */
+    [[nodiscard]] Bitboard
+    defendersOf(Coord coord) const;
+
+    /***
+     * @param coord the coordinate being attacked
+     * @param color the color of the attacking pieces
+     * @returns true if any piece of the given color attacks the given coordinate
+     */
+    [[nodiscard]] bool
+    isAttacked(Coord coord, Color color) const;
+
+    /***
+     * @param coord the coordinate of a portal
+     * @returns the coordinate of the portal linked to the given one, if it is linked
+     */
+    [[nodiscard]] std::optional<Coord>
+    portalPartner(Coord coord) const;
+
+    /***
+     * Take one step from the given coordinate, following the portal rules.
+     * @param from the coordinate to step from
+     * @param step the step to take
+     * @returns the coordinate reached, or an empty std::optional if the step leaves the board or
+     * is blocked by a portal
+     */
+    [[nodiscard]] std::optional<Coord>
+    step(Coord from, Step step) const;
+
+    /***
+     * Take one step from the given coordinate by the given offset, following the portal rules.
+     * @param from the coordinate to step from
+     * @param files the number of files to step, positive towards H
+     * @param ranks the number of ranks to step, positive towards 8
+     * @returns the coordinate reached, or an empty std::optional if the step leaves the board or
+     * is blocked by a portal
+     * @throws std::invalid_argument if the offset is not one of the steps in stepOffsets
+     */
+    [[nodiscard]] std::optional<Coord>
+    step(Coord from, int files, int ranks) const;
+};
+
+namespace detail {
+
+inline int
+colorIndex(Color color) {
+    return static_cast<int>(color);
+}
+
+// Names squares the same way Coord does on a standard board, e.g. "A1".
+template<typename G>
+std::string
+describeSquare(int square) {
+    std::stringstream ss;
+    ss << static_cast<char>('A' + G::fileOf(square)) << G::rankOf(square) + 1;
+    return ss.str();
+}
+
+} // namespace detail
+
+template<typename G>
+BasicAttackMap<G>::BasicAttackMap()
+    : pieces_{}
+    , colors_{}
+    , portals_{}
+    , partners_{}
+    , attacks_{}
+    , touched_{}
+    , attackers_{} {
+    partners_.fill(-1);
+}
+
+template<typename G>
+BasicAttackMap<G>::BasicAttackMap(const std::vector<std::pair<int, Piece>> &pieces)
+    : BasicAttackMap() {
+    for (auto &[square, piece] : pieces) {
+        if (pieces_[square]) {
+            throw invalid_piece(
+                "Cannot add piece to " + detail::describeSquare<G>(square) +
+                ": this space is occupied");
+        }
+        place(square, piece);
+    }
+    rebuild();
+}
+
+template<typename G>
+void
+BasicAttackMap<G>::addPiece(int square, Piece piece) {
+    if (pieces_[square]) {
+        throw invalid_piece(
+            "Cannot add piece to " + detail::describeSquare<G>(square) +
+            ": this space is occupied");
+    }
+    place(square, piece);
+    auto changed = G::bit(square);
+    if (piece.type == Type::Portal) changed |= relink(piece.color);
+    update(changed);
+}
+
+template<typename G>
+void
+BasicAttackMap<G>::removePiece(int square) {
+    if (!pieces_[square]) {
+        throw invalid_piece(
+            "Cannot remove piece from " + detail::describeSquare<G>(square) +
+            ": this space is empty");
+    }
+    auto piece = *pieces_[square];
+    clear(square);
+    auto changed = G::bit(square);
+    if (piece.type == Type::Portal) changed |= relink(piece.color);
+    update(changed);
+}
+
+template<typename G>
+void
+BasicAttackMap<G>::movePiece(int from, int to) {
+    if (pieces_[to]) {
+        throw invalid_piece(
+            "Cannot move piece to " + detail::describeSquare<G>(to) +
+            ": this space is occupied");
+    }
+    if (!pieces_[from]) {
+        throw invalid_piece(
+            "Cannot move piece from " + detail::describeSquare<G>(from) +
+            ": this space is empty");
+    }
+    auto piece = *pieces_[from];
+    clear(from);
+    place(to, piece);
+    auto changed = G::bit(from) | G::bit(to);
+    if (piece.type == Type::Portal) changed |= relink(piece.color);
+    update(changed);
+}
+
+template<typename G>
+const std::optional<Piece> &
+BasicAttackMap<G>::at(int square) const {
+    return pieces_[square];
+}
+
+template<typename G>
+typename G::Mask
+BasicAttackMap<G>::attacksFrom(int square) const {
+    return attacks_[square];
+}
+
+template<typename G>
+typename G::Mask
+BasicAttackMap<G>::attackersOf(int square, Color color) const {
+    return attackers_[square] & colors_[detail::colorIndex(color)];
+}
+
+template<typename G>
+typename G::Mask
+BasicAttackMap<G>::defendersOf(int square) const {
+    auto &piece = pieces_[square];
+    if (!piece || piece->type == Type::Portal) return Mask{0};
+    return attackersOf(square, piece->color);
+}
+
+template<typename G>
+bool
+BasicAttackMap<G>::isAttacked(int square, Color color) const {
+    return static_cast<bool>(attackersOf(square, color));
+}
+
+template<typename G>
+int
+BasicAttackMap<G>::portalPartner(int square) const {
+    return partners_[square];
+}
+
+template<typename G>
+int
+BasicAttackMap<G>::step(int from, Step step) const {
+    Mask touched{0};
+    return follow(from, step, touched);
+}
+
+template<typename G>
+typename G::Mask
+BasicAttackMap<G>::pieces(Color color) const {
+    return colors_[detail::colorIndex(color)];
+}
+
+template<typename G>
+typename G::Mask
+BasicAttackMap<G>::portals(Color color) const {
+    return portals_[detail::colorIndex(color)];
+}
+
+template<typename G>
+void
+BasicAttackMap<G>::place(int square, Piece piece) {
+    pieces_[square] = piece;
+    auto &mask      = piece.type == Type::Portal ? portals_ : colors_;
+    mask[detail::colorIndex(piece.color)] |= G::bit(square);
+}
+
+template<typename G>
+void
+BasicAttackMap<G>::rebuild() {
+    (void)relink(Color::White);
+    (void)relink(Color::Black);
+    for (int square = 0; square < G::squares; square++) {
+        recompute(square);
+    }
+}
+
+template<typename G>
+void
+BasicAttackMap<G>::clear(int square) {
+    retract(square);
+    auto mask = ~G::bit(square);
+    for (auto &bits : colors_) bits &= mask;
+    for (auto &bits : portals_) bits &= mask;
+    pieces_[square] = std::nullopt;
+}
+
+template<typename G>
+void
+BasicAttackMap<G>::retract(int square) {
+    auto mask = ~G::bit(square);
+    forEachSquare(attacks_[square], [&](int target) { attackers_[target] &= mask; });
+    attacks_[square] = Mask{0};
+    touched_[square] = Mask{0};
+}
+
+template<typename G>
+typename G::Mask
+BasicAttackMap<G>::relink(Color color) {
+    // Adding, removing or moving a portal can change which portals of its color are linked, so
+    // every square that held or holds one of them is reported as changed. Squares still holding
+    // a portal of the other color keep their links.
+    Mask changed = portals_[detail::colorIndex(color)];
+    for (int square = 0; square < G::squares; square++) {
+        auto &piece = pieces_[square];
+        if (partners_[square] >= 0 && !(piece && piece->color != color)) {
+            changed |= G::bit(square);
+            partners_[square] = -1;
+        }
+    }
+
+    auto portals = portals_[detail::colorIndex(color)];
+    if (countSquares(portals) == 2) {
+        auto first = lowestSquare(portals);
+        clearLowest(portals);
+        auto second       = lowestSquare(portals);
+        partners_[first]  = second;
+        partners_[second] = first;
+    }
+    return changed;
+}
+
+template<typename G>
+void
+BasicAttackMap<G>::update(Mask changed) {
+    auto occupied = colors_[0] | colors_[1];
+    Mask affected = changed & occupied;
+    forEachSquare(occupied, [&](int square) {
+        if (touched_[square] & changed) affected |= G::bit(square);
+    });
+    forEachSquare(affected, [&](int square) { recompute(square); });
+}
+
+template<typename G>
+void
+BasicAttackMap<G>::recompute(int square) {
+    static constexpr Step rookSteps[]      = {East, West, North, South};
+    static constexpr Step bishopSteps[]    = {NorthEast, SouthEast, NorthWest, SouthWest};
+    static constexpr Step whitePawnSteps[] = {NorthWest, NorthEast};
+    static constexpr Step blackPawnSteps[] = {SouthWest, SouthEast};
+
+    retract(square);
+
+    auto &piece = pieces_[square];
+    if (!piece || piece->type == Type::Portal) return;
+
+    auto occupied = colors_[0] | colors_[1];
+    Mask attacks{0};
+    Mask touched{0};
+
+    auto leap = [&](Step step) {
+        auto to = follow(square, step, touched);
+        if (to >= 0 && to != square) attacks |= G::bit(to);
+    };
+    auto slide = [&](Step step) {
+        // A ray through portals can only revisit a square by returning to its origin.
+        for (auto from = square;;) {
+            auto to = follow(from, step, touched);
+            if (to < 0 || to == square) break;
+            attacks |= G::bit(to);
+            if (occupied & G::bit(to)) break;
+            from = to;
+        }
+    };
+
+    switch (piece->type) {
+        case Type::Bishop:
+            for (auto step : bishopSteps) slide(step);
+            break;
+        case Type::Rook:
+            for (auto step : rookSteps) slide(step);
+            break;
+        case Type::Queen:
+            for (auto step : bishopSteps) slide(step);
+            for (auto step : rookSteps) slide(step);
+            break;
+        case Type::King:
+            for (auto step : bishopSteps) leap(step);
+            for (auto step : rookSteps) leap(step);
+            break;
+        case Type::Knight:
+            for (int step = KnightFirst; step < StepCount; step++) leap(static_cast<Step>(step));
+            break;
+        case Type::Pawn:
+            if (piece->color == Color::White) {
+                for (auto step : whitePawnSteps) leap(step);
+            } else {
+                for (auto step : blackPawnSteps) leap(step);
+            }
+            break;
+        case Type::Portal: break;
+    }
+
+    attacks_[square] = attacks;
+    touched_[square] = touched;
+    auto bit         = G::bit(square);
+    forEachSquare(attacks, [&](int target) { attackers_[target] |= bit; });
+}
+
+template<typename G>
+int
+BasicAttackMap<G>::follow(int from, Step step, Mask &touched) const {
+    auto allPortals = portals_[0] | portals_[1];
+
+    auto to = G::neighbor(from, step);
+    if (to < 0) return -1;
+    touched |= G::bit(to);
+    if (allPortals & G::bit(to)) {
+        if (partners_[to] < 0) return -1;
+        to = G::neighbor(partners_[to], step);
+        if (to < 0) return -1;
+        touched |= G::bit(to);
+        if (allPortals & G::bit(to)) return -1;
+    }
+    return to;
+}
+
+// The standard board is instantiated once, in attacks.cpp.
+extern template class BasicAttackMap<StandardGeometry>;
+
+} // namespace Chess
+
+#endif // PORTAL_CHESS_INCLUDE_ATTACKS_H
@@ -0,0 +1,443 @@
+//
+// Created by taylor-santos on 10/19/2026 at 02:15.
+//
+
+#ifndef PORTAL_CHESS_INCLUDE_AUDIO_H
+#define PORTAL_CHESS_INCLUDE_AUDIO_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace Chess::Audio {
+
+// OGG Vorbis files can only be decoded when stb_vorbis.c was found at configure time (see
+// src/CMakeLists.txt). WAV files can always be decoded.
+#ifdef PORTAL_CHESS_HAVE_STB_VORBIS
+constexpr bool oggSupported = true;
+#else
+constexpr bool oggSupported = false;
+#endif
+
+// The number of channels in every Sound held by a SoundBank, and in every block written to an
+// Output.
+constexpr unsigned outputChannels = 2;
+
+// Decoded audio as interleaved signed 16-bit samples.
+struct Sound {
+    unsigned                  channels   = 0;
+    unsigned                  sampleRate = 0;
+    std::vector<std::int16_t> samples;
+
+    /***
+     * @returns the number of samples per channel
+     */
+    [[nodiscard]] std::size_t
+    frames() const;
+};
+
+/***
+ * Decode a RIFF WAVE file holding 8, 16, 24 or 32-bit integer PCM, or 32-bit float PCM. Float
+ * samples outside [-1, 1] are clipped.
+ * @param data the contents of the file
+ * @returns the decoded Sound
+ * @throws std::runtime_error if the data is not a supported WAV file, or holds a NaN sample
+ */
+[[nodiscard]] Sound
+decodeWav(const std::vector<std::uint8_t> &data);
+
+/***
+ * Decode an OGG Vorbis file.
+ * @param data the contents of the file
+ * @returns the decoded Sound
+ * @throws std::runtime_error if the data is not a valid OGG Vorbis file, or if oggSupported is
+ * false
+ */
+[[nodiscard]] Sound
+decodeOgg(const std::vector<std::uint8_t> &data);
+
+/***
+ * Decode a WAV or OGG Vorbis file, detected by its leading magic bytes.
+ * @param data the contents of the file
+ * @returns the decoded Sound
+ * @throws std::runtime_error if the data is not a supported audio file
+ */
+[[nodiscard]] Sound
+decode(const std::vector<std::uint8_t> &data);
+
+/***
+ * @param sound the Sound to encode
+ * @returns the given Sound as a 16-bit PCM WAV file
+ */
+[[nodiscard]] std::vector<std::uint8_t>
+encodeWav(const Sound &sound);
+
+/***
+ * Convert a Sound to stereo at the given sample rate. Mono sounds are copied to both channels,
+ * and only the first two channels of sounds with more than two are kept. The sample rate is
+ * converted by linear interpolation.
+ * @param sound the Sound to convert
+ * @param sampleRate the sample rate to convert to
+ * @returns the converted Sound
+ * @throws std::invalid_argument if either sample rate or the number of channels is 0
+ */
+[[nodiscard]] Sound
+resample(const Sound &sound, unsigned sampleRate);
+
+using SoundId = std::uint32_t;
+
+/***
+ * Every sound effect, decoded and converted to the output format once when it is added, so that
+ * playing a sound never decodes, resamples or allocates. Sounds are never removed, and references
+ * returned by operator[] stay valid for the lifetime of the SoundBank.
+ */
+class SoundBank {
+public:
+    /***
+     * @param sampleRate the sample rate of the Output the sounds will be played on
+     * @throws std::invalid_argument if sampleRate is 0
+     */
+    explicit SoundBank(unsigned sampleRate);
+
+    SoundBank(const SoundBank &) = delete;
+
+    /***
+     * Add a decoded Sound, converting it to stereo at this bank's sample rate.
+     * @param name the name to find the sound by
+     * @param sound the Sound to add
+     * @returns the id of the added sound
+     * @throws std::invalid_argument if a sound with the given name already exists
+     */
+    SoundId
+    add(const std::string &name, const Sound &sound);
+
+    /***
+     * Read, decode and add an audio file, named after the file name without its extension.
+     * @param path the file to load
+     * @returns the id of the added sound
+     * @throws std::runtime_error naming the file if it cannot be read or decoded
+     * @throws std::invalid_argument if a sound with the same name already exists
+     */
+    SoundId
+    load(const std::filesystem::path &path);
+
+    /***
+     * Load every ".wav" and ".ogg" file in a directory, in name order. Files with other
+     * extensions are ignored.
+     * @param directory the directory to load
+     * @returns the number of sounds added
+     * @throws std::runtime_error naming the first file that cannot be read or decoded, including
+     * any ".ogg" file if oggSupported is false. The files before it have been added.
+     * @throws std::invalid_argument if a sound with the same name already exists
+     */
+    std::size_t
+    loadDirectory(const std::filesystem::path &directory);
+
+    /***
+     * @param name the name of a sound
+     * @returns the id of the sound with the given name, or an empty std::optional if there is none
+     */
+    [[nodiscard]] std::optional<SoundId>
+    find(std::string_view name) const;
+
+    /***
+     * @param id the id of a sound in this bank
+     * @returns the sound, as interleaved stereo at this bank's sample rate
+     */
+    [[nodiscard]] const Sound &
+    operator[](SoundId id) const;
+
+    /***
+     * @returns the number of sounds in the bank
+     */
+    [[nodiscard]] std::size_t
+    size() const;
+
+    /***
+     * @returns the sample rate every sound was converted to
+     */
+    [[nodiscard]] unsigned
+    sampleRate() const;
+
+private:
+    unsigned                                  sampleRate_;
+    std::vector<std::unique_ptr<const Sound>> sounds_;
+    std::unordered_map<std::string, SoundId>  ids_;
+};
+
+/***
+ * A fixed-capacity, lock-free queue for exactly one producer thread and one consumer thread.
+ * Neither side ever blocks or allocates: tryPush() fails when the queue is full and tryPop()
+ * fails when it is empty.
+ */
+template<typename T, std::size_t Capacity>
+class SpscQueue {
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be 2^n");
+
+public:
+    SpscQueue()
+        : head_{0}
+        , tail_{0} {}
+
+    SpscQueue(const SpscQueue &) = delete;
+
+    /***
+     * Add an item to the back of the queue. May only be called from the producer thread.
+     * @param item the item to add
+     * @returns false if the queue was full, in which case the item was not added
+     */
+    bool
+    tryPush(const T &item) {
+        auto tail = tail_.load(std::memory_order_relaxed);
+        if (tail - head_.load(std::memory_order_acquire) == Capacity) return false;
+        items_[tail % Capacity] = item;
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /***
+     * Remove the item at the front of the queue. May only be called from the consumer thread.
+     * @returns the removed item, or an empty std::optional if the queue was empty
+     */
+    [[nodiscard]] std::optional<T>
+    tryPop() {
+        auto head = head_.load(std::memory_order_relaxed);
+        if (head == tail_.load(std::memory_order_acquire)) return std::nullopt;
+        T item = items_[head % Capacity];
+        head_.store(head + 1, std::memory_order_release);
+        return item;
+    }
+
+private:
+    // The consumer writes head_ and the producer writes tail_, so each gets its own cache line.
+    alignas(64) std::atomic<std::size_t> head_;
+    alignas(64) std::atomic<std::size_t> tail_;
+    std::array<T, Capacity>              items_;
+};
+
+/***
+ * Mixes the sounds in a SoundBank into interleaved stereo 16-bit blocks. play() and stopAll()
+ * are called from one control thread (typically the UI thread) and only enqueue a command;
+ * render() is called from one audio thread and applies every queued command before mixing. The
+ * control thread therefore never waits for the audio thread, and a sound starts at the beginning
+ * of the next rendered block however busy the rest of the program is.
+ */
+class Mixer {
+public:
+    // The number of sounds that can play at once. Playing another sound replaces the one that
+    // has been playing longest.
+    static constexpr std::size_t maxVoices = 32;
+
+    // The number of commands that can be queued between two calls to render().
+    static constexpr std::size_t commandCapacity = 256;
+
+    // The loudest gain play() accepts, about +24 dB. Even with every voice at this gain, the mix
+    // of full-scale samples cannot overflow its 32-bit accumulator.
+    static constexpr float maxGain = 16.0f;
+
+    /***
+     * @param bank the sounds to play, which must outlive the Mixer
+     */
+    explicit Mixer(const SoundBank &bank);
+
+    Mixer(const Mixer &) = delete;
+
+    /***
+     * Start playing a sound from the beginning. May only be called from the control thread.
+     * @param id the id of a sound in the SoundBank
+     * @param gain the volume to play the sound at, where 1 is the volume it was recorded at,
+     *        clamped to [0, maxGain]. NaN plays silently.
+     * @returns false if the command queue was full, in which case the sound will not play
+     * @throws std::out_of_range if the SoundBank has no sound with the given id
+     */
+    bool
+    play(SoundId id, float gain = 1.0f);
+
+    /***
+     * Stop every sound that is playing. May only be called from the control thread.
+     * @returns false if the command queue was full
+     */
+    bool
+    stopAll();
+
+    /***
+     * Apply every queued command, then mix the playing sounds into the given block, clipping
+     * samples that overflow. May only be called from the audio thread.
+     * @param samples the block to write, as interleaved stereo
+     * @param frames the number of frames in the block
+     */
+    void
+    render(std::int16_t *samples, std::size_t frames);
+
+    /***
+     * @returns the number of sounds playing as of the last call to render(). May only be called
+     * from the audio thread.
+     */
+    [[nodiscard]] std::size_t
+    activeVoices() const;
+
+    /***
+     * @returns the sample rate of the sounds being mixed
+     */
+    [[nodiscard]] unsigned
+    sampleRate() const;
+
+private:
+    struct Command {
+        enum class Kind { Play, StopAll } kind;
+
+        const Sound *sound;
+        int          gain;
+    };
+
+    struct Voice {
+        const Sound *sound;
+        std::size_t  position;
+        int          gain;
+    };
+
+    const SoundBank                    &bank_;
+    SpscQueue<Command, commandCapacity> commands_;
+    std::array<Voice, maxVoices>        voices_;
+    std::size_t                         voiceCount_;
+};
+
+/***
+ * Where mixed audio goes. write() blocks until the output has room for the block, the way a
+ * sound device does, which is what paces the audio thread.
+ */
+class Output {
+public:
+    virtual ~Output() = default;
+
+    /***
+     * @returns the sample rate the output plays at
+     */
+    [[nodiscard]] virtual unsigned
+    sampleRate() const = 0;
+
+    /***
+     * Write a block of audio.
+     * @param samples the block, as interleaved stereo
+     * @param frames the number of frames in the block
+     */
+    virtual void
+    write(const std::int16_t *samples, std::size_t frames) = 0;
+};
+
+/***
+ * Discards everything written to it, for running without a sound device.
+ */
+class NullOutput : public Output {
+public:
+    /***
+     * @param sampleRate the sample rate to pretend to play at
+     * @param realtime whether write() should block until the previous blocks would have finished
+     *        playing, as a device would. Otherwise write() returns immediately.
+     */
+    explicit NullOutput(unsigned sampleRate, bool realtime = true);
+
+    [[nodiscard]] unsigned
+    sampleRate() const override;
+
+    void
+    write(const std::int16_t *samples, std::size_t frames) override;
+
+    /***
+     * @returns the number of frames written so far. Safe to call from any thread.
+     */
+    [[nodiscard]] std::uint64_t
+    framesWritten() const;
+
+private:
+    unsigned                              sampleRate_;
+    bool                                  realtime_;
+    std::atomic<std::uint64_t>            frames_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+/***
+ * Records everything written to it to a 16-bit stereo WAV file, for checking what would have been
+ * heard without a sound device. The file is complete once the FileOutput is destroyed.
+ */
+class FileOutput : public Output {
+public:
+    /***
+     * @param path the WAV file to create
+     * @param sampleRate the sample rate to record at
+     * @param realtime whether write() should block until the previous blocks would have finished
+     *        playing, as a device would. Otherwise write() returns immediately.
+     * @throws std::runtime_error if the file cannot be created
+     */
+    FileOutput(const std::filesystem::path &path, unsigned sampleRate, bool realtime = true);
+
+    ~FileOutput() override;
+
+    [[nodiscard]] unsigned
+    sampleRate() const override;
+
+    void
+    write(const std::int16_t *samples, std::size_t frames) override;
+
+    /***
+     * @returns the number of frames written so far. Safe to call from any thread.
+     */
+    [[nodiscard]] std::uint64_t
+    framesWritten() const;
+
+private:
+    std::ofstream file_;
+    NullOutput    clock_;
+};
+
+/***
+ * The audio thread: repeatedly renders a block from a Mixer and writes it to an Output until
+ * destroyed. A sound passed to Mixer::play() is heard within one block plus whatever the Output
+ * buffers.
+ */
+class AudioThread {
+public:
+    // 256 frames is about 5 ms at 48 kHz.
+    static constexpr std::size_t defaultBlockFrames = 256;
+
+    /***
+     * Start the audio thread.
+     * @param mixer the Mixer to render, which must outlive the AudioThread
+     * @param output the Output to write to
+     * @param blockFrames the number of frames to render at a time
+     * @throws std::invalid_argument if output is null, blockFrames is 0, or the Output's sample
+     * rate is not the mixer's SoundBank's sample rate
+     */
+    AudioThread(
+        Mixer                  &mixer,
+        std::unique_ptr<Output> output,
+        std::size_t             blockFrames = defaultBlockFrames);
+
+    AudioThread(const AudioThread &) = delete;
+
+    /***
+     * Stop the audio thread after the block it is rendering, and destroy the Output.
+     */
+    ~AudioThread();
+
+private:
+    std::unique_ptr<Output>   output_;
+    std::vector<std::int16_t> block_;
+    std::atomic<bool>         stopping_;
+    std::thread               thread_;
+};
+
+} // namespace Chess::Audio
+
+#endif // PORTAL_CHESS_INCLUDE_AUDIO_H
@@ -5,11 +5,14 @@
 #ifndef PORTAL_CHESS_INCLUDE_BOARD_H
 #define PORTAL_CHESS_INCLUDE_BOARD_H
 
+#include <array>
 #include <vector>
 #include <stdexcept>
 #include <memory>
 #include <optional>
 #include <functional>
+#include <limits>
+#include <cstdint>
 
 namespace Chess {
 
@@ -21,22 +24,37 @@ using incomplete_ptr = std::unique_ptr<T, std::function<void(T *)>>;
 
 class Piece;
 class Coord;
+struct SquareChange;
 
 class Board {
 public:
+    static constexpr std::size_t unlimitedHistory = std::numeric_limits<std::size_t>::max();
+
     Board(const Board &) = delete;
-    virtual ~Board()     = default;
+
+    /***
+     * Releases this Board's history. Ancestors that are not shared with any other Board are
+     * released iteratively, so dropping a very long history does not recurse once per move. This
+     * relies on an unshared ancestor never being revived while it is released, so code outside
+     * Board must not lock a std::weak_ptr to a Board that another thread may be releasing.
+     */
+    virtual ~Board();
 
     /***
      * Construct a new Board from a list of pieces and return it wrapped in an std::shared_ptr.
      * @param pieces a list of (coord, piece) pairs to be added to the board, where coord is the
      *        location for the piece, and piece is a std::shared_ptr to a Piece
+     * @param historyBudget the approximate number of bytes that the history of this Board and of
+     *        every Board derived from it may occupy. Once a derived Board's history exceeds this
+     *        budget it is replaced by a flattened copy, releasing the older history.
      * @returns a newly constructed Board wrapped in a std::shared_ptr, containing the given
      * pieces
      * @throws invalid_piece if two or more of the given pieces have overlapping coordinates
      */
     [[nodiscard]] static std::shared_ptr<const Board>
-    make(std::vector<std::pair<Coord, incomplete_ptr<Piece>>> pieces);
+    make(
+        std::vector<std::pair<Coord, incomplete_ptr<Piece>>> pieces,
+        std::size_t historyBudget = unlimitedHistory);
 
     /***
      * Retrieve a piece from the Board at the given coordinate.
@@ -79,15 +97,98 @@ public:
     [[nodiscard]] std::shared_ptr<const Board>
     movePiece(Coord from, Coord to) const;
 
+    /***
+     * Construct a new Board with the same pieces as this Board, but with no history. The new
+     * Board keeps this Board's history budget.
+     * @returns a new Board state containing a copy of every piece on this Board
+     */
+    [[nodiscard]] std::shared_ptr<const Board>
+    flatten() const;
+
+    /***
+     * Construct a new Board with the same pieces as this Board, which forwards lookups to this
+     * Board. The new Board holds the only reference to this Board that it or any Board derived
+     * from it will ever take, so a thread that branches once from a Board shared with other
+     * threads, and then derives only from its branch, never touches the shared Board's reference
+     * count again. Its reference counting then costs the same regardless of how many threads share
+     * the original Board.
+     * @returns a new Board state with the same pieces as this Board
+     */
+    [[nodiscard]] std::shared_ptr<const Board>
+    branch() const;
+
+    /***
+     * @returns the approximate number of bytes occupied by this Board and its history, back to
+     * the most recent Board created by make() or flatten()
+     */
+    [[nodiscard]] std::size_t
+    historyBytes() const;
+
+    /***
+     * @returns a Zobrist hash of the pieces on this Board. Boards with the same pieces on the
+     * same coordinates always have the same hash, regardless of their history.
+     */
+    [[nodiscard]] std::uint64_t
+    hash() const;
+
+    /***
+     * Compare the pieces on two Boards, ignoring their histories.
+     * @param other the Board to compare against
+     * @returns true if every coordinate holds an equal piece, or no piece, on both Boards
+     */
+    bool
+    operator==(const Board &other) const;
+
+    bool
+    operator!=(const Board &other) const;
+
+    friend std::vector<SquareChange>
+    diff(const Board &from, const Board &to);
+
+    friend std::optional<std::size_t>
+    historyDistance(const Board &from, const Board &to);
+
 private:
     class InitialBoard;
     class AddedPiece;
     class RemovedPiece;
     class MovedPiece;
+    class Branch;
 
-    Board() = default;
+    Board(std::shared_ptr<const Board> parent, std::size_t nodeBytes);
 
-    std::weak_ptr<Board> wptr_;
+    template<typename T, typename... Args>
+    [[nodiscard]] std::shared_ptr<const Board>
+    derive(Args &&...args) const;
+
+    // One square changed by a node, numbered (rank - 1) * 8 + (file - 1), with its contents in
+    // the node's parent and in the node. nullptr is an empty square.
+    struct Edit {
+        int          square;
+        const Piece *before;
+        const Piece *after;
+    };
+
+    // Write the squares this node changed relative to its parent to out, and return how many
+    // there are. None for a Board with no parent.
+    [[nodiscard]] virtual std::size_t
+    edits(std::array<Edit, 2> &out) const = 0;
+
+    // Walk the deeper of two Boards up towards the root until both reach the same node, calling
+    // visit with each node passed and whether it is an ancestor of to rather than from. Returns
+    // false, having stopped at a root, if the Boards share no history.
+    static bool
+    walkToCommonAncestor(
+        const Board                                    &from,
+        const Board                                    &to,
+        const std::function<void(const Board &, bool)> &visit);
+
+    std::shared_ptr<const Board> parent_;
+    std::size_t                  depth_;
+    std::size_t                  historyBudget_;
+    std::size_t                  historyBytes_;
+    std::uint64_t                hash_;
+    std::weak_ptr<Board>         wptr_;
 };
 
 class invalid_piece : public std::runtime_error {
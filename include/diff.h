@@ -0,0 +1,50 @@
+//
+// Created by taylor-santos on 10/18/2026 at 20:58.
+//
+
+#ifndef PORTAL_CHESS_INCLUDE_DIFF_H
+#define PORTAL_CHESS_INCLUDE_DIFF_H
+
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+#include "board.h"
+#include "coord.h"
+
+namespace Chess {
+
+class Piece;
+
+struct SquareChange {
+    Coord                        coord;
+    std::optional<const Piece *> before;
+    std::optional<const Piece *> after;
+};
+
+/***
+ * Find every coordinate whose contents differ between two Boards. If the Boards share an
+ * ancestor, only the history between each of them and their nearest common ancestor is visited,
+ * and only the coordinates it touched are compared, so the cost depends on the number of changes
+ * rather than the length of the history. Otherwise every coordinate is compared.
+ * @param from the earlier Board
+ * @param to the later Board
+ * @returns the changed coordinates in order from A1 to H8, each with the piece it holds on each
+ * Board. The pieces are owned by the Boards and are only valid while they are.
+ */
+[[nodiscard]] std::vector<SquareChange>
+diff(const Board &from, const Board &to);
+
+/***
+ * @param from a Board
+ * @param to another Board
+ * @returns the number of history nodes diff() visits for the given Boards: the number of changes,
+ * including branches, from each of them back to their nearest common ancestor. An empty
+ * std::optional if they share no history.
+ */
+[[nodiscard]] std::optional<std::size_t>
+historyDistance(const Board &from, const Board &to);
+
+} // namespace Chess
+
+#endif // PORTAL_CHESS_INCLUDE_DIFF_H
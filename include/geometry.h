@@ -0,0 +1,287 @@
+//
+// Created by taylor-santos on 10/18/2026 at 19:40.
+//
+
+#ifndef PORTAL_CHESS_INCLUDE_GEOMETRY_H
+#define PORTAL_CHESS_INCLUDE_GEOMETRY_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#if defined(_MSC_VER)
+#    include <intrin.h>
+#endif
+
+namespace Chess {
+
+/***
+ * A set of squares for boards with more than 64 squares, supporting the same bitwise operators as
+ * the std::uint64_t used for smaller boards.
+ */
+template<std::size_t N>
+class WideMask {
+public:
+    static constexpr std::size_t wordCount = (N + 63) / 64;
+
+    constexpr WideMask()
+        : words_{} {}
+
+    // Sets the squares below 64, so that WideMask{0} mirrors std::uint64_t{0}.
+    constexpr explicit WideMask(std::uint64_t low)
+        : words_{} {
+        words_[0] = low;
+    }
+
+    /***
+     * @returns the set holding only the given square
+     */
+    [[nodiscard]] static constexpr WideMask
+    bit(int square) {
+        WideMask result;
+        result.words_[square / 64] = std::uint64_t{1} << (square % 64);
+        return result;
+    }
+
+    [[nodiscard]] constexpr WideMask
+    operator~() const {
+        WideMask result;
+        for (std::size_t i = 0; i < wordCount; i++) {
+            result.words_[i] = ~words_[i];
+        }
+        if (N % 64) result.words_[wordCount - 1] &= (std::uint64_t{1} << (N % 64)) - 1;
+        return result;
+    }
+
+    constexpr WideMask &
+    operator|=(const WideMask &other) {
+        for (std::size_t i = 0; i < wordCount; i++) words_[i] |= other.words_[i];
+        return *this;
+    }
+
+    constexpr WideMask &
+    operator&=(const WideMask &other) {
+        for (std::size_t i = 0; i < wordCount; i++) words_[i] &= other.words_[i];
+        return *this;
+    }
+
+    [[nodiscard]] constexpr WideMask
+    operator|(const WideMask &other) const {
+        auto result = *this;
+        return result |= other;
+    }
+
+    [[nodiscard]] constexpr WideMask
+    operator&(const WideMask &other) const {
+        auto result = *this;
+        return result &= other;
+    }
+
+    [[nodiscard]] constexpr explicit operator bool() const {
+        for (auto word : words_) {
+            if (word) return true;
+        }
+        return false;
+    }
+
+    [[nodiscard]] constexpr bool
+    operator==(const WideMask &other) const {
+        for (std::size_t i = 0; i < wordCount; i++) {
+            if (words_[i] != other.words_[i]) return false;
+        }
+        return true;
+    }
+
+    [[nodiscard]] constexpr bool
+    operator!=(const WideMask &other) const {
+        return !(*this == other);
+    }
+
+    [[nodiscard]] const std::array<std::uint64_t, wordCount> &
+    words() const {
+        return words_;
+    }
+
+    void
+    clearLowest() {
+        for (auto &word : words_) {
+            if (word) {
+                word &= word - 1;
+                return;
+            }
+        }
+    }
+
+private:
+    std::array<std::uint64_t, wordCount> words_;
+};
+
+/***
+ * @param bits a non-empty set of squares
+ * @returns the index of the lowest square in the given set
+ */
+[[nodiscard]] inline int
+lowestSquare(std::uint64_t bits) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward64(&index, bits);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctzll(bits);
+#endif
+}
+
+template<std::size_t N>
+[[nodiscard]] int
+lowestSquare(const WideMask<N> &bits) {
+    int base = 0;
+    for (auto word : bits.words()) {
+        if (word) return base + lowestSquare(word);
+        base += 64;
+    }
+    return -1;
+}
+
+inline void
+clearLowest(std::uint64_t &bits) {
+    bits &= bits - 1;
+}
+
+template<std::size_t N>
+void
+clearLowest(WideMask<N> &bits) {
+    bits.clearLowest();
+}
+
+/***
+ * Call visit with the index of each square in the given set, from lowest to highest.
+ */
+template<typename Mask, typename Visit>
+void
+forEachSquare(Mask bits, Visit visit) {
+    while (bits) {
+        visit(lowestSquare(bits));
+        clearLowest(bits);
+    }
+}
+
+/***
+ * @returns the number of squares in the given set
+ */
+template<typename Mask>
+[[nodiscard]] int
+countSquares(Mask bits) {
+    int count = 0;
+    for (; bits; clearLowest(bits)) count++;
+    return count;
+}
+
+// The single steps pieces take, as indices into stepOffsets: four orthogonal directions, four
+// diagonal directions, then the eight leaps of a knight.
+enum Step : int {
+    East,
+    West,
+    North,
+    South,
+    NorthEast,
+    SouthEast,
+    NorthWest,
+    SouthWest,
+    KnightFirst,
+    StepCount = KnightFirst + 8
+};
+
+struct StepOffset {
+    int files;
+    int ranks;
+};
+
+constexpr StepOffset stepOffsets[StepCount] = {
+    {1, 0},
+    {-1, 0},
+    {0, 1},
+    {0, -1},
+    {1, 1},
+    {1, -1},
+    {-1, 1},
+    {-1, -1},
+    {1, 2},
+    {2, 1},
+    {2, -1},
+    {1, -2},
+    {-1, -2},
+    {-2, -1},
+    {-2, 1},
+    {-1, 2}};
+
+template<int Files, int Ranks>
+constexpr std::array<std::array<std::int16_t, StepCount>, Files * Ranks>
+makeNeighbors() {
+    std::array<std::array<std::int16_t, StepCount>, Files * Ranks> table{};
+    for (int square = 0; square < Files * Ranks; square++) {
+        for (int step = 0; step < StepCount; step++) {
+            auto file           = square % Files + stepOffsets[step].files;
+            auto rank           = square / Files + stepOffsets[step].ranks;
+            bool inside         = 0 <= file && file < Files && 0 <= rank && rank < Ranks;
+            table[square][step] = static_cast<std::int16_t>(inside ? rank * Files + file : -1);
+        }
+    }
+    return table;
+}
+
+/***
+ * The dimensions of a board, as compile-time constants, with precomputed tables of each square's
+ * neighbors. Squares are numbered rank * files + file, counting both from zero.
+ *
+ * Code templated on a Geometry is fully specialized for its dimensions. Boards of up to 64
+ * squares store sets of squares in a std::uint64_t, larger boards in a WideMask.
+ */
+template<int Files, int Ranks>
+struct Geometry {
+    static_assert(Files >= 2 && Ranks >= 4, "boards must have at least 2 files and 4 ranks");
+    static_assert(Files * Ranks <= 32767, "square indices must fit in an std::int16_t");
+
+    static constexpr int files   = Files;
+    static constexpr int ranks   = Ranks;
+    static constexpr int squares = Files * Ranks;
+
+    using Mask = std::
+        conditional_t<(squares <= 64), std::uint64_t, WideMask<static_cast<std::size_t>(squares)>>;
+
+    [[nodiscard]] static constexpr int
+    fileOf(int square) {
+        return square % Files;
+    }
+
+    [[nodiscard]] static constexpr int
+    rankOf(int square) {
+        return square / Files;
+    }
+
+    [[nodiscard]] static constexpr Mask
+    bit(int square) {
+        if constexpr (std::is_same_v<Mask, std::uint64_t>) {
+            return std::uint64_t{1} << square;
+        } else {
+            return Mask::bit(square);
+        }
+    }
+
+    /***
+     * @returns the square one step from the given square, or -1 if the step leaves the board
+     */
+    [[nodiscard]] static constexpr int
+    neighbor(int square, Step step) {
+        return neighbors[square][step];
+    }
+
+private:
+    static constexpr auto neighbors = makeNeighbors<Files, Ranks>();
+};
+
+using StandardGeometry = Geometry<8, 8>;
+
+} // namespace Chess
+
+#endif // PORTAL_CHESS_INCLUDE_GEOMETRY_H
@@ -0,0 +1,99 @@
+//
+// Created by taylor-santos on 10/18/2026 at 18:20.
+//
+
+#ifndef PORTAL_CHESS_INCLUDE_HISTORY_H
+#define PORTAL_CHESS_INCLUDE_HISTORY_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace Chess {
+
+/***
+ * The hashes of the positions in a game or search line, stored in a fixed-size ring buffer.
+ * Repetitions are found by scanning only the positions since the last irreversible move, and only
+ * those with the same side to move, without walking or comparing any Boards.
+ *
+ * Only the most recent PositionHistory::capacity positions are kept, so repetitions further apart
+ * than that are not detected. No such repetition can affect a fifty-move draw, since the window
+ * is then already longer than 100 plies.
+ */
+class PositionHistory {
+public:
+    static constexpr std::size_t capacity = 1024;
+
+    // The number of plies without a capture or pawn move after which a fifty-move draw applies.
+    static constexpr std::size_t fiftyMovePlies = 100;
+
+    /***
+     * Construct a PositionHistory containing only the initial position.
+     * @param hash the hash of the initial position, e.g. from Board::hash()
+     * @param halfmoveClock the number of plies since the last irreversible move before the
+     *        initial position
+     */
+    explicit PositionHistory(std::uint64_t hash, std::size_t halfmoveClock = 0);
+
+    /***
+     * Record the position reached by a move.
+     * @param hash the hash of the new position
+     * @param irreversible true if the move was a capture or pawn move, so that no earlier
+     *        position can ever be repeated
+     */
+    void
+    push(std::uint64_t hash, bool irreversible);
+
+    /***
+     * Forget the most recently recorded position, undoing the last push().
+     * @throws std::out_of_range if only one position is left, or if the previous position has
+     *         already been overwritten in the ring buffer
+     */
+    void
+    pop();
+
+    /***
+     * @returns the number of earlier occurrences of the current position, with the same side to
+     * move, since the last irreversible move
+     */
+    [[nodiscard]] std::size_t
+    repetitions() const;
+
+    /***
+     * @returns true if the current position has occurred at least three times
+     */
+    [[nodiscard]] bool
+    isThreefoldRepetition() const;
+
+    /***
+     * @returns true if no capture or pawn move has been made in the last fifty moves by each side
+     */
+    [[nodiscard]] bool
+    isFiftyMoveDraw() const;
+
+    /***
+     * @returns the number of plies since the last irreversible move
+     */
+    [[nodiscard]] std::size_t
+    halfmoveClock() const;
+
+    /***
+     * @returns the number of positions recorded, including those no longer kept in the buffer
+     */
+    [[nodiscard]] std::size_t
+    size() const;
+
+private:
+    struct Entry {
+        std::uint64_t hash;
+        std::size_t   halfmoveClock;
+    };
+
+    std::array<Entry, capacity> entries_;
+    std::size_t                 size_;
+    std::size_t                 retained_;
+};
+
+} // namespace Chess
+
+#endif // PORTAL_CHESS_INCLUDE_HISTORY_H
@@ -0,0 +1,79 @@
+//
+// Created by taylor-santos on 10/18/2026 at 11:52.
+//
+
+#ifndef PORTAL_CHESS_INCLUDE_INTERNER_H
+#define PORTAL_CHESS_INCLUDE_INTERNER_H
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace Chess {
+
+class Board;
+
+/***
+ * A thread-safe pool of canonical Boards. Interning two Boards with the same pieces returns the
+ * same flattened Board, so positions reached through different move orders share one node and
+ * can be compared with a pointer comparison.
+ */
+class BoardInterner {
+public:
+    /***
+     * Construct an empty BoardInterner.
+     * @param shards the number of independently locked partitions of the pool. More shards
+     *        reduce contention between threads interning at the same time.
+     * @throws std::invalid_argument if shards is zero
+     */
+    explicit BoardInterner(std::size_t shards = 64);
+
+    BoardInterner(const BoardInterner &) = delete;
+
+    /***
+     * Retrieve the canonical Board with the same pieces as the given Board, adding a flattened
+     * copy of it to the pool if no such Board exists yet.
+     * @param board the Board to intern
+     * @returns a Board with the same pieces as the given Board, which is pointer-equal to the
+     * result of every other call with an equal Board
+     */
+    [[nodiscard]] std::shared_ptr<const Board>
+    intern(const Board &board);
+
+    /***
+     * Remove every canonical Board that is no longer referenced outside of this pool.
+     * @returns the number of Boards removed
+     */
+    std::size_t
+    prune();
+
+    /***
+     * Remove every canonical Board from the pool. Boards previously returned by intern() remain
+     * valid, but are no longer canonical.
+     */
+    void
+    clear();
+
+    /***
+     * @returns the number of canonical Boards in the pool
+     */
+    [[nodiscard]] std::size_t
+    size() const;
+
+private:
+    struct alignas(64) Shard {
+        mutable std::mutex                                                   mutex;
+        std::unordered_multimap<std::uint64_t, std::shared_ptr<const Board>> boards;
+    };
+
+    [[nodiscard]] Shard &
+    shardFor(std::uint64_t hash);
+
+    std::vector<Shard> shards_;
+};
+
+} // namespace Chess
+
+#endif // PORTAL_CHESS_INCLUDE_INTERNER_H
@@ -0,0 +1,425 @@
+//
+// Created by taylor-santos on 10/18/2026 at 16:12.
+//
+
+#ifndef PORTAL_CHESS_INCLUDE_MOVEGEN_H
+#define PORTAL_CHESS_INCLUDE_MOVEGEN_H
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <optional>
+#include <ostream>
+#include <vector>
+
+#include "attacks.h"
+#include "coord.h"
+#include "piece.h"
+
+namespace Chess {
+
+class Board;
+
+struct Move {
+    Coord               from;
+    Coord               to;
+    std::optional<Type> promotion;
+
+    bool
+    operator==(const Move &other) const;
+
+    bool
+    operator!=(const Move &other) const;
+};
+
+std::ostream &
+operator<<(std::ostream &os, const Move &move);
+
+// A move on a board of any Geometry, with squares identified by their Geometry index.
+struct BasicMove {
+    int                 from;
+    int                 to;
+    std::optional<Type> promotion;
+
+    bool
+    operator==(const BasicMove &other) const;
+
+    bool
+    operator!=(const BasicMove &other) const;
+};
+
+/***
+ * The check and pin masks for one side of a position, computed once so that the legality of each
+ * pseudo-legal move is a mask test. Checks and pins delivered through linked portals are included.
+ *
+ * Like BasicAttackMap, this and the move generation templates below are defined at the end of this
+ * header, so any Geometry can be used. Only the standard board is compiled into the library.
+ */
+template<typename G>
+class BasicLegalityMasks {
+public:
+    using Mask = typename G::Mask;
+
+    /***
+     * Compute the masks for the given side.
+     * @param map the attacks in the position
+     * @param color the side to move
+     */
+    BasicLegalityMasks(const BasicAttackMap<G> &map, Color color);
+
+    /***
+     * @returns true if the side to move's king is attacked
+     */
+    [[nodiscard]] bool
+    inCheck() const;
+
+    /***
+     * @returns the squares of every piece giving check to the side to move's king
+     */
+    [[nodiscard]] Mask
+    checkers() const;
+
+    /***
+     * @param move a pseudo-legal move for the side to move
+     * @returns true if making the given move would not leave the side to move's king attacked
+     */
+    [[nodiscard]] bool
+    isLegal(const BasicMove &move) const;
+
+private:
+    int                          king_;
+    Mask                         checkers_;
+    Mask                         checkMask_;
+    Mask                         kingDanger_;
+    std::array<Mask, G::squares> pinMasks_;
+};
+
+/***
+ * The BasicLegalityMasks for a standard board, which can also test Moves given by coordinate.
+ */
+class LegalityMasks : public BasicLegalityMasks<StandardGeometry> {
+public:
+    /***
+     * Compute the masks for the given side.
+     * @param map the attacks in the position
+     * @param color the side to move
+     */
+    LegalityMasks(const AttackMap &map, Color color);
+
+    using BasicLegalityMasks::isLegal;
+
+    /***
+     * @param move a pseudo-legal move for the side to move
+     * @returns true if making the given move would not leave the side to move's king attacked
+     */
+    [[nodiscard]] bool
+    isLegal(const Move &move) const;
+};
+
+/***
+ * Generate every move for the given side that follows piece movement rules, without checking
+ * whether it leaves that side's king attacked. Portals do not move. Pawns move one square forward,
+ * or two from their starting rank, capture diagonally forward, and promote on the last rank.
+ * Castling and en passant are not supported.
+ * @param map the attacks in the position
+ * @param color the side to move
+ * @returns the pseudo-legal moves for the given side
+ */
+template<typename G>
+[[nodiscard]] std::vector<BasicMove>
+pseudoLegalMoves(const BasicAttackMap<G> &map, Color color);
+
+/***
+ * Generate every pseudo-legal move for the given side that does not leave its king attacked.
+ * @param map the attacks in the position
+ * @param color the side to move
+ * @returns the legal moves for the given side
+ */
+template<typename G>
+[[nodiscard]] std::vector<BasicMove>
+legalMoves(const BasicAttackMap<G> &map, Color color);
+
+/***
+ * @param map the attacks in the position
+ * @param color the color of the king to test
+ * @returns true if a king of the given color is attacked by the other side
+ */
+template<typename G>
+[[nodiscard]] bool
+inCheck(const BasicAttackMap<G> &map, Color color);
+
+/***
+ * Update a BasicAttackMap with the given move made, capturing any piece on the destination.
+ * @param map the BasicAttackMap to update
+ * @param move the move to make
+ * @throws invalid_piece if the move's origin is empty
+ */
+template<typename G>
+void
+applyMove(BasicAttackMap<G> &map, const BasicMove &move);
+
+/***
+ * The same as pseudoLegalMoves(const BasicAttackMap<G> &, Color), with moves given by coordinate.
+ */
+[[nodiscard]] std::vector<Move>
+pseudoLegalMoves(const AttackMap &map, Color color);
+
+/***
+ * The same as legalMoves(const BasicAttackMap<G> &, Color), with moves given by coordinate.
+ */
+[[nodiscard]] std::vector<Move>
+legalMoves(const AttackMap &map, Color color);
+
+/***
+ * Construct a new Board with the given move made, capturing any piece on the destination.
+ * @param board the Board to make the move on
+ * @param move the move to make
+ * @returns a new Board state with the move made
+ * @throws invalid_piece if the move's origin is empty
+ */
+[[nodiscard]] std::shared_ptr<const Board>
+applyMove(const Board &board, const Move &move);
+
+/***
+ * Update an AttackMap with the given move made, capturing any piece on the destination.
+ * @param map the AttackMap to update
+ * @param move the move to make
+ * @throws invalid_piece if the move's origin is empty
+ */
+void
+applyMove(AttackMap &map, const Move &move);
+
+namespace detail {
+
+struct Direction {
+    Step step;
+    bool diagonal;
+};
+
+inline constexpr Direction directions[] = {
+    {East, false},
+    {West, false},
+    {North, false},
+    {South, false},
+    {NorthEast, true},
+    {SouthEast, true},
+    {NorthWest, true},
+    {SouthWest, true}};
+
+inline constexpr Type promotions[] = {Type::Queen, Type::Rook, Type::Bishop, Type::Knight};
+
+inline Color
+opponent(Color color) {
+    return color == Color::White ? Color::Black : Color::White;
+}
+
+inline bool
+slidesAlong(Type type, const Direction &direction) {
+    return type == Type::Queen || type == (direction.diagonal ? Type::Bishop : Type::Rook);
+}
+
+inline bool
+isSlider(Type type) {
+    return type == Type::Queen || type == Type::Rook || type == Type::Bishop;
+}
+
+// Walk a sliding ray from the given square through linked portals, calling visit with each square
+// reached, until visit returns false, the ray ends, or the ray returns to its origin.
+template<typename G, typename Visit>
+void
+trace(const BasicAttackMap<G> &map, int from, const Direction &direction, Visit visit) {
+    for (auto at = from;;) {
+        auto next = map.step(at, direction.step);
+        if (next < 0 || next == from || !visit(next)) return;
+        at = next;
+    }
+}
+
+template<typename G>
+int
+findKing(const BasicAttackMap<G> &map, Color color) {
+    int king = -1;
+    forEachSquare(map.pieces(color), [&](int square) {
+        if (king < 0 && map.at(square)->type == Type::King) king = square;
+    });
+    return king;
+}
+
+} // namespace detail
+
+template<typename G>
+BasicLegalityMasks<G>::BasicLegalityMasks(const BasicAttackMap<G> &map, Color color)
+    : king_{detail::findKing(map, color)}
+    , checkers_{0}
+    , checkMask_{~Mask{0}}
+    , kingDanger_{0}
+    , pinMasks_{} {
+    pinMasks_.fill(~Mask{0});
+    if (king_ < 0) return;
+
+    auto enemy    = detail::opponent(color);
+    auto occupied = map.pieces(Color::White) | map.pieces(Color::Black);
+
+    forEachSquare(map.pieces(enemy), [&](int square) { kingDanger_ |= map.attacksFrom(square); });
+
+    // A sliding checker's ray must be blocked on every path it takes to the king, and the king
+    // may not retreat along any of those paths, since it no longer blocks them once it moves.
+    checkers_   = map.attackersOf(king_, enemy);
+    auto blocks = ~Mask{0};
+    forEachSquare(checkers_, [&](int checker) {
+        auto type = map.at(checker)->type;
+        if (!detail::isSlider(type)) {
+            blocks = Mask{0};
+            return;
+        }
+        for (auto &direction : detail::directions) {
+            if (!detail::slidesAlong(type, direction)) continue;
+            Mask path{0};
+            Mask beyond{0};
+            bool hit = false;
+            detail::trace(map, checker, direction, [&](int square) {
+                if (square == king_) {
+                    hit = true;
+                    return true;
+                }
+                (hit ? beyond : path) |= G::bit(square);
+                return !(occupied & G::bit(square));
+            });
+            if (hit) {
+                blocks &= path;
+                kingDanger_ |= beyond;
+            }
+        }
+    });
+    if (checkers_) checkMask_ = countSquares(checkers_) == 1 ? checkers_ | blocks : Mask{0};
+
+    // Trace outwards from the king. An own piece followed by an enemy slider moving along the
+    // same ray is pinned to the squares between the king and that slider, including the slider.
+    for (auto &direction : detail::directions) {
+        int  pinned = -1;
+        Mask ray{0};
+        detail::trace(map, king_, direction, [&](int square) {
+            ray |= G::bit(square);
+            if (!(occupied & G::bit(square))) return true;
+            auto &piece = *map.at(square);
+            if (pinned < 0) {
+                if (piece.color != color) return false;
+                pinned = square;
+                return true;
+            }
+            if (piece.color != color && detail::slidesAlong(piece.type, direction)) {
+                pinMasks_[pinned] &= ray;
+            }
+            return false;
+        });
+    }
+}
+
+template<typename G>
+bool
+BasicLegalityMasks<G>::inCheck() const {
+    return static_cast<bool>(checkers_);
+}
+
+template<typename G>
+typename G::Mask
+BasicLegalityMasks<G>::checkers() const {
+    return checkers_;
+}
+
+template<typename G>
+bool
+BasicLegalityMasks<G>::isLegal(const BasicMove &move) const {
+    if (king_ < 0) return true;
+    auto to = G::bit(move.to);
+    if (move.from == king_) return !(kingDanger_ & to);
+    return (checkMask_ & to) && (pinMasks_[move.from] & to);
+}
+
+template<typename G>
+std::vector<BasicMove>
+pseudoLegalMoves(const BasicAttackMap<G> &map, Color color) {
+    auto own      = map.pieces(color);
+    auto enemy    = map.pieces(detail::opponent(color));
+    auto occupied = own | enemy;
+
+    auto forward   = color == Color::White ? North : South;
+    auto startRank = color == Color::White ? 1 : G::ranks - 2;
+    auto lastRank  = color == Color::White ? G::ranks - 1 : 0;
+
+    std::vector<BasicMove> moves;
+    forEachSquare(own, [&](int from) {
+        if (map.at(from)->type != Type::Pawn) {
+            forEachSquare(map.attacksFrom(from) & ~own, [&](int to) {
+                moves.push_back({from, to, std::nullopt});
+            });
+            return;
+        }
+
+        auto addPawn = [&](int to) {
+            if (G::rankOf(to) == lastRank) {
+                for (auto type : detail::promotions) moves.push_back({from, to, type});
+            } else {
+                moves.push_back({from, to, std::nullopt});
+            }
+        };
+
+        auto one = map.step(from, forward);
+        if (one >= 0 && !(occupied & G::bit(one))) {
+            addPawn(one);
+            auto two = G::rankOf(from) == startRank ? map.step(one, forward) : -1;
+            if (two >= 0 && !(occupied & G::bit(two))) addPawn(two);
+        }
+        forEachSquare(map.attacksFrom(from) & enemy, addPawn);
+    });
+    return moves;
+}
+
+template<typename G>
+std::vector<BasicMove>
+legalMoves(const BasicAttackMap<G> &map, Color color) {
+    BasicLegalityMasks<G> masks{map, color};
+    auto                  moves = pseudoLegalMoves(map, color);
+    moves.erase(
+        std::remove_if(
+            moves.begin(),
+            moves.end(),
+            [&](const BasicMove &move) { return !masks.isLegal(move); }),
+        moves.end());
+    return moves;
+}
+
+template<typename G>
+bool
+inCheck(const BasicAttackMap<G> &map, Color color) {
+    auto king = detail::findKing(map, color);
+    return king >= 0 && map.isAttacked(king, detail::opponent(color));
+}
+
+template<typename G>
+void
+applyMove(BasicAttackMap<G> &map, const BasicMove &move) {
+    if (map.at(move.to)) map.removePiece(move.to);
+    map.movePiece(move.from, move.to);
+    if (move.promotion) {
+        auto color = map.at(move.to)->color;
+        map.removePiece(move.to);
+        map.addPiece(move.to, {*move.promotion, color});
+    }
+}
+
+// The standard board is instantiated once, in movegen.cpp.
+extern template class BasicLegalityMasks<StandardGeometry>;
+
+extern template std::vector<BasicMove>
+pseudoLegalMoves(const BasicAttackMap<StandardGeometry> &, Color);
+extern template std::vector<BasicMove>
+legalMoves(const BasicAttackMap<StandardGeometry> &, Color);
+extern template bool
+inCheck(const BasicAttackMap<StandardGeometry> &, Color);
+extern template void
+applyMove(BasicAttackMap<StandardGeometry> &, const BasicMove &);
+
+} // namespace Chess
+
+#endif // PORTAL_CHESS_INCLUDE_MOVEGEN_H
@@ -0,0 +1,104 @@
+//
+// Created by taylor-santos on 10/18/2026 at 21:34.
+//
+
+#ifndef PORTAL_CHESS_INCLUDE_PACKED_H
+#define PORTAL_CHESS_INCLUDE_PACKED_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+
+#include "board.h"
+#include "coord.h"
+#include "piece.h"
+
+namespace Chess {
+
+/***
+ * The pieces of a position packed into 32 bytes, with no history. Each square is one nibble,
+ * holding 0 if it is empty or 1 + type * 2 + color otherwise. Square (rank - 1) * 8 + (file - 1)
+ * is stored in the low nibble of its byte if it is even, and the high nibble if it is odd.
+ *
+ * Packing, unpacking, comparison and hashing work on whole 16-byte blocks where SSE2 is
+ * available, and fall back to scalar code elsewhere.
+ */
+class alignas(16) PackedBoard {
+public:
+    static constexpr std::size_t bytes = 32;
+
+    /***
+     * Construct a PackedBoard with no pieces.
+     */
+    PackedBoard();
+
+    /***
+     * Construct a PackedBoard holding the pieces on the given Board.
+     * @param board the Board to pack
+     */
+    explicit PackedBoard(const Board &board);
+
+    /***
+     * Construct a new Board holding the pieces in this PackedBoard.
+     * @param historyBudget the history budget of the new Board, as in Board::make()
+     * @returns a newly constructed Board with no history
+     */
+    [[nodiscard]] std::shared_ptr<const Board>
+    unpack(std::size_t historyBudget = Board::unlimitedHistory) const;
+
+    /***
+     * @param coord the coordinate to look up
+     * @returns the piece at the given coordinate, if one exists
+     */
+    [[nodiscard]] std::optional<Piece>
+    at(Coord coord) const;
+
+    /***
+     * @returns the packed bytes
+     */
+    [[nodiscard]] const std::array<std::uint8_t, bytes> &
+    data() const;
+
+    /***
+     * @returns a hash of the packed bytes. This is not the same as Board::hash().
+     */
+    [[nodiscard]] std::uint64_t
+    hash() const;
+
+    bool
+    operator==(const PackedBoard &other) const;
+
+    bool
+    operator!=(const PackedBoard &other) const;
+
+    /***
+     * Order PackedBoards by their packed bytes, compared lexicographically. The order has no
+     * meaning beyond being consistent, so that PackedBoards can be sorted and searched.
+     */
+    bool
+    operator<(const PackedBoard &other) const;
+
+private:
+    std::array<std::uint8_t, bytes> data_;
+};
+
+static_assert(sizeof(PackedBoard) == PackedBoard::bytes, "PackedBoard must not be padded");
+
+} // namespace Chess
+
+namespace std {
+
+template<>
+struct hash<Chess::PackedBoard> {
+    std::size_t
+    operator()(const Chess::PackedBoard &board) const {
+        return static_cast<std::size_t>(board.hash());
+    }
+};
+
+} // namespace std
+
+#endif // PORTAL_CHESS_INCLUDE_PACKED_H
@@ -0,0 +1,218 @@
+//
+// Created by taylor-santos on 10/19/2026 at 00:12.
+//
+
+#ifndef PORTAL_CHESS_INCLUDE_PIPELINE_H
+#define PORTAL_CHESS_INCLUDE_PIPELINE_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <istream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "search.h"
+
+namespace Chess {
+
+/***
+ * A fixed set of worker threads running submitted tasks. Each worker has its own queue: tasks
+ * submitted by a worker go to the front of its own queue, and other tasks are spread over the
+ * back of the queues in turn. Workers run tasks from the front of their own queue, and when it is
+ * empty steal from the front of the others', so that one slow task never holds up the tasks
+ * queued behind it. Tasks submitted from outside the pool therefore start in the order they were
+ * submitted, while a worker runs the tasks it submitted itself before picking up new work.
+ */
+class ThreadPool {
+public:
+    /***
+     * Start the given number of worker threads.
+     * @param threads the number of workers
+     * @throws std::invalid_argument if threads is 0
+     */
+    explicit ThreadPool(unsigned threads);
+
+    ThreadPool(const ThreadPool &) = delete;
+
+    /***
+     * Run every task already submitted, then stop the workers.
+     */
+    ~ThreadPool();
+
+    /***
+     * Queue a task to be run by one of the workers. Tasks must not throw.
+     * @param task the task to run
+     */
+    void
+    submit(std::function<void()> task);
+
+    /***
+     * @returns the number of worker threads
+     */
+    [[nodiscard]] unsigned
+    size() const;
+
+private:
+    struct alignas(64) Queue {
+        std::mutex                        mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    void
+    work(std::size_t index);
+
+    [[nodiscard]] std::optional<std::function<void()>>
+    take(std::size_t index);
+
+    std::vector<Queue>       queues_;
+    std::vector<std::thread> workers_;
+    std::mutex               mutex_;
+    std::condition_variable  wake_;
+    std::size_t              pending_;
+    std::size_t              nextQueue_;
+    bool                     stopping_;
+};
+
+/***
+ * Collects results that complete in any order and releases them in the order their sequence
+ * numbers were reserved. At most capacity results can be reserved but not yet released, so
+ * reserve() blocks a producer that gets too far ahead of the consumer, and memory use stays
+ * bounded however many results pass through.
+ */
+template<typename T>
+class ReorderBuffer {
+public:
+    /***
+     * @param capacity the maximum number of results reserved but not yet released
+     * @throws std::invalid_argument if capacity is 0
+     */
+    explicit ReorderBuffer(std::size_t capacity)
+        : slots_(capacity)
+        , reserved_{0}
+        , released_{0}
+        , closed_{false} {
+        if (capacity == 0) throw std::invalid_argument("ReorderBuffer capacity must be nonzero");
+    }
+
+    /***
+     * Wait until there is room for another result, and reserve its place in the output order.
+     * @returns the sequence number to pass to complete()
+     * @throws std::logic_error if close() has been called
+     */
+    [[nodiscard]] std::size_t
+    reserve() {
+        std::unique_lock lock{mutex_};
+        hasRoom_.wait(lock, [&] { return closed_ || reserved_ - released_ < slots_.size(); });
+        if (closed_) throw std::logic_error("ReorderBuffer::reserve() called after close()");
+        return reserved_++;
+    }
+
+    /***
+     * Provide the result for a reserved sequence number.
+     * @param sequence a sequence number returned by reserve()
+     * @param value the result
+     */
+    void
+    complete(std::size_t sequence, T value) {
+        {
+            std::lock_guard lock{mutex_};
+            slots_[sequence % slots_.size()] = std::move(value);
+        }
+        hasResult_.notify_all();
+    }
+
+    /***
+     * Wait for the result with the next sequence number.
+     * @returns the next result, or an empty std::optional once close() has been called and every
+     * reserved result has been released
+     */
+    [[nodiscard]] std::optional<T>
+    next() {
+        std::unique_lock lock{mutex_};
+        auto            &slot = slots_[released_ % slots_.size()];
+        hasResult_.wait(lock, [&] { return slot || (closed_ && released_ == reserved_); });
+        if (!slot) return std::nullopt;
+
+        std::optional<T> result;
+        result.swap(slot);
+        released_++;
+        lock.unlock();
+        hasRoom_.notify_one();
+        return result;
+    }
+
+    /***
+     * Stop accepting reservations. next() keeps returning results until every reserved result
+     * has been released.
+     */
+    void
+    close() {
+        {
+            std::lock_guard lock{mutex_};
+            closed_ = true;
+        }
+        hasRoom_.notify_all();
+        hasResult_.notify_all();
+    }
+
+private:
+    std::vector<std::optional<T>> slots_;
+    std::size_t                   reserved_;
+    std::size_t                   released_;
+    bool                          closed_;
+    std::mutex                    mutex_;
+    std::condition_variable       hasRoom_;
+    std::condition_variable       hasResult_;
+};
+
+struct AnalysisOptions {
+    SearchLimits limits;
+
+    // The number of search threads.
+    unsigned threads = 1;
+
+    // The maximum number of positions read but not yet written.
+    std::size_t window = 64;
+
+    // The number of transposition table entries for each search thread.
+    std::size_t tableEntries = std::size_t{1} << 16U;
+};
+
+/***
+ * Analyze one game, as read by parseGame(). The Search is cleared first, so that the result
+ * depends only on the line, the limits and the size of the Search's transposition table.
+ * @param line the game to analyze
+ * @param search the Search to run
+ * @param limits the limits for the search
+ * @returns the result, written as "bestmove <move> score <score> depth <depth> nodes <nodes>", or
+ * "error <message>" if the line is not a valid game. Mate scores are written as "mate <plies>",
+ * negative if the side to move is getting mated.
+ */
+[[nodiscard]] std::string
+analyzeLine(const std::string &line, Search &search, const SearchLimits &limits);
+
+/***
+ * Analyze every game in a stream, one per line, searching them in parallel and writing the
+ * results in input order. Each output line is the input line, a tab, and the result from
+ * analyzeLine(). Empty lines and lines starting with '#' are skipped. Memory use depends only on
+ * the options, not on the length of the input.
+ * @param in the stream to read games from
+ * @param out the stream to write results to
+ * @param options the search limits, thread count and window size
+ * @returns the number of games analyzed
+ * @throws std::invalid_argument if options.threads or options.window is 0
+ */
+std::size_t
+analyze(std::istream &in, std::ostream &out, const AnalysisOptions &options);
+
+} // namespace Chess
+
+#endif // PORTAL_CHESS_INCLUDE_PIPELINE_H
@@ -0,0 +1,64 @@
+//
+// Created by taylor-santos on 10/18/2026 at 22:41.
+//
+
+#ifndef PORTAL_CHESS_INCLUDE_POSITION_H
+#define PORTAL_CHESS_INCLUDE_POSITION_H
+
+#include <string>
+#include <string_view>
+
+#include "movegen.h"
+#include "packed.h"
+#include "piece.h"
+
+namespace Chess {
+
+// A position to analyze: the pieces on the board and the side to move.
+struct Position {
+    PackedBoard board;
+    Color       toMove;
+};
+
+/***
+ * Parse a position written like the first two fields of FEN: the ranks from 8 down to 1
+ * separated by '/', each listing its squares from A to H as piece letters or counts of empty
+ * squares, then "w" or "b" for the side to move. Pieces are written K, Q, R, B, N, P and O for
+ * portals, in upper case for White and lower case for Black.
+ * @param text the position to parse, e.g. "4k3/8/8/3o4/8/8/8/O3K3 w"
+ * @returns the parsed Position
+ * @throws std::invalid_argument if the text is not a valid position
+ */
+[[nodiscard]] Position
+parsePosition(std::string_view text);
+
+/***
+ * @param position the Position to write
+ * @returns the given Position in the format read by parsePosition()
+ */
+[[nodiscard]] std::string
+formatPosition(const Position &position);
+
+/***
+ * Parse a move written as its origin and destination coordinates, followed by '=' and a piece
+ * letter for promotions, as printed by operator<<(std::ostream &, const Move &).
+ * @param text the move to parse, e.g. "E2E4" or "B7B8=Q"
+ * @returns the parsed Move
+ * @throws std::invalid_argument if the text is not a valid move
+ */
+[[nodiscard]] Move
+parseMove(std::string_view text);
+
+/***
+ * Parse a game: a position as read by parsePosition(), optionally followed by the word "moves"
+ * and a list of moves made from that position, separated by spaces.
+ * @param text the game to parse, e.g. "4k3/8/8/8/8/8/4P3/4K3 w moves E2E4 E8D7"
+ * @returns the Position reached after making every move
+ * @throws std::invalid_argument if the text is not a valid game, or if any move is illegal
+ */
+[[nodiscard]] Position
+parseGame(std::string_view text);
+
+} // namespace Chess
+
+#endif // PORTAL_CHESS_INCLUDE_POSITION_H
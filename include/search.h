@@ -0,0 +1,173 @@
+//
+// Created by taylor-santos on 10/18/2026 at 23:20.
+//
+
+#ifndef PORTAL_CHESS_INCLUDE_SEARCH_H
+#define PORTAL_CHESS_INCLUDE_SEARCH_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+
+#include "attacks.h"
+#include "movegen.h"
+#include "piece.h"
+#include "timeman.h"
+#include "transposition.h"
+
+namespace Chess {
+
+struct SearchLimits {
+    // The deepest iteration to search, in plies.
+    int depth = 64;
+
+    // The number of nodes after which to stop searching, or 0 for no limit.
+    std::uint64_t nodes = 0;
+
+    // The side to move's clock, to budget the search's time from, or an empty std::optional to
+    // search without a time limit.
+    std::optional<TimeControl> clock;
+
+    // Whether this search is pondering: searching the position expected after the opponent's
+    // reply, on the opponent's time. The clock is ignored until Search::ponderHit() is called, and
+    // a search that reaches its other limits first waits for Search::ponderHit() or
+    // Search::stop() before returning.
+    bool ponder = false;
+};
+
+struct SearchResult {
+    // The best move found, or an empty std::optional if the side to move has no legal moves.
+    std::optional<Move> bestMove;
+
+    // The opponent's expected reply to the best move, to ponder on, if one is known.
+    std::optional<Move> ponderMove;
+
+    // The score of the best move in centipawns, from the side to move's point of view. Scores
+    // beyond Search::mateThreshold are mates, Search::mateScore minus the number of plies to mate.
+    int score = 0;
+
+    // The depth of the deepest completed iteration.
+    int depth = 0;
+
+    // The number of nodes searched, including those of any unfinished iteration.
+    std::uint64_t nodes = 0;
+};
+
+/***
+ * @param map the attacks in the position
+ * @param color the side to evaluate for
+ * @returns a static evaluation of the position in centipawns from the given side's point of view,
+ * counting material and the number of squares each side attacks
+ */
+[[nodiscard]] int
+evaluate(const AttackMap &map, Color color);
+
+/***
+ * An iterative-deepening alpha-beta search with a capture-only quiescence search and a
+ * transposition table. A Search may be reused for many positions, but only by one thread at a
+ * time. The transposition table is kept from one run to the next, so searching the positions of
+ * one game with the same Search reuses the work of earlier moves.
+ *
+ * To ponder, run a search with SearchLimits::ponder set on the position after the previous
+ * result's ponderMove. If the opponent plays that move, call ponderHit(): the search continues
+ * where it is, now on our own clock. Otherwise call stop() and search the actual position, which
+ * still benefits from the table entries the ponder search stored. A pondering search never
+ * returns before one of the two, even once it has reached its depth or node limit.
+ *
+ * run() never forgets a stop() or ponderHit() by itself, so that one made just before the search
+ * gets going is not lost. Call arm() before starting each search that may be stopped, before
+ * handing it to the thread that runs it.
+ */
+class Search {
+public:
+    static constexpr int maxDepth      = 64;
+    static constexpr int mateScore     = 1000000;
+    static constexpr int mateThreshold = mateScore - 1000;
+
+    // 2^18 entries of 16 bytes: 4 MiB.
+    static constexpr std::size_t defaultTableEntries = std::size_t{1} << 18U;
+
+    /***
+     * @param tableEntries the number of transposition table entries, rounded down to a power of
+     *        two
+     * @throws std::invalid_argument if tableEntries is zero
+     */
+    explicit Search(std::size_t tableEntries = defaultTableEntries);
+
+    /***
+     * Search a position until the given limits are reached, its time runs out, or stop() is
+     * called. If stop() has been called since the last arm(), returns at once.
+     * @param map the attacks in the position
+     * @param toMove the side to move
+     * @param limits when to stop searching
+     * @returns the result of the deepest completed iteration
+     */
+    [[nodiscard]] SearchResult
+    run(const AttackMap &map, Color toMove, const SearchLimits &limits);
+
+    /***
+     * Forget any earlier stop() or ponderHit(), ready for the next call to run(). Must not be
+     * called while run() is running.
+     */
+    void
+    arm();
+
+    /***
+     * Make the current or next call to run() return as soon as possible, with the result of its
+     * deepest completed iteration. Safe to call from any thread.
+     */
+    void
+    stop();
+
+    /***
+     * Tell the current or next pondering search that the opponent played the expected move. The
+     * search starts using its clock from this moment. Safe to call from any thread.
+     */
+    void
+    ponderHit();
+
+    /***
+     * Forget everything learned by earlier searches, e.g. before searching an unrelated position.
+     */
+    void
+    clear();
+
+private:
+    [[nodiscard]] int
+    negamax(const AttackMap &map, Color color, int depth, int ply, int alpha, int beta);
+
+    [[nodiscard]] int
+    quiesce(const AttackMap &map, Color color, int ply, int alpha, int beta);
+
+    [[nodiscard]] bool
+    visit();
+
+    [[nodiscard]] bool
+    pondering() const;
+
+    void
+    waitForPonderEnd();
+
+    [[nodiscard]] TimeManager::Duration
+    elapsed() const;
+
+    TranspositionTable                          table_;
+    std::atomic<bool>                           stop_;
+    std::atomic<bool>                           ponderHit_;
+    std::mutex                                  mutex_;
+    std::condition_variable                     ponderEnded_;
+    std::atomic<std::chrono::steady_clock::rep> clockStart_;
+    const TimeManager                          *timer_;
+    bool                                        ponder_;
+    bool                                        aborted_;
+    std::uint64_t                               nodes_;
+    std::uint64_t                               nodeLimit_;
+};
+
+} // namespace Chess
+
+#endif // PORTAL_CHESS_INCLUDE_SEARCH_H
@@ -0,0 +1,256 @@
+//
+// Created by taylor-santos on 10/18/2026 at 09:12.
+//
+
+#ifndef PORTAL_CHESS_INCLUDE_STATS_H
+#define PORTAL_CHESS_INCLUDE_STATS_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+
+namespace Chess::Stats {
+
+// Instrumentation is only collected when the project is configured with -DPORTAL_CHESS_STATS=ON.
+// Otherwise every recording function below is an empty inline function and compiles out entirely.
+#ifdef PORTAL_CHESS_STATS
+constexpr bool enabled = true;
+#else
+constexpr bool enabled = false;
+#endif
+
+enum class Counter {
+    BoardNodes,     // Board nodes successfully constructed
+    Allocations,    // heap allocations made through Stats::Allocator
+    AllocatedBytes, // bytes requested by those allocations
+    InvalidPiece,   // invalid_piece exceptions constructed
+    AtCalls,        // top-level Board::at() lookups
+    AtDepth,        // history-chain nodes visited by those lookups
+    SearchNodes,    // nodes visited by the search
+    Count
+};
+
+enum class Gauge {
+    AtMaxDepth, // deepest history chain walked by a single Board::at() lookup
+    Count
+};
+
+enum class Timer {
+    Search, // wall time spent inside the search
+    Count
+};
+
+constexpr std::size_t counterCount = static_cast<std::size_t>(Counter::Count);
+constexpr std::size_t gaugeCount   = static_cast<std::size_t>(Gauge::Count);
+constexpr std::size_t timerCount   = static_cast<std::size_t>(Timer::Count);
+
+[[nodiscard]] const char *
+name(Counter counter);
+
+[[nodiscard]] const char *
+name(Gauge gauge);
+
+[[nodiscard]] const char *
+name(Timer timer);
+
+/***
+ * A point-in-time total of every thread's counters, including threads that have since exited.
+ */
+struct Snapshot {
+    struct TimerTotal {
+        std::uint64_t calls = 0;
+        std::uint64_t nanos = 0;
+    };
+
+    std::array<std::uint64_t, counterCount> counters{};
+    std::array<std::uint64_t, gaugeCount>   gauges{};
+    std::array<TimerTotal, timerCount>      timers{};
+
+    [[nodiscard]] std::uint64_t
+    operator[](Counter counter) const;
+
+    [[nodiscard]] std::uint64_t
+    operator[](Gauge gauge) const;
+
+    [[nodiscard]] const TimerTotal &
+    operator[](Timer timer) const;
+
+    /***
+     * @returns the mean number of history-chain nodes visited per top-level Board::at() lookup,
+     * or 0 if no lookups have been recorded
+     */
+    [[nodiscard]] double
+    averageAtDepth() const;
+
+    /***
+     * @returns the number of search nodes visited per second of time spent in Timer::Search, or
+     * 0 if no search time has been recorded
+     */
+    [[nodiscard]] double
+    searchNodesPerSecond() const;
+
+    /***
+     * Write this snapshot to the given stream as a single JSON object.
+     * @param os the stream to write to
+     */
+    void
+    toJson(std::ostream &os) const;
+};
+
+namespace detail {
+
+// Each thread owns one Slot. Only the owning thread writes to it, so updates are plain relaxed
+// load/store pairs rather than locked read-modify-writes. The alignment keeps slots belonging to
+// different threads on separate cache lines.
+struct alignas(64) Slot {
+    std::array<std::atomic<std::uint64_t>, counterCount> counters{};
+    std::array<std::atomic<std::uint64_t>, gaugeCount>   gauges{};
+    std::array<std::atomic<std::uint64_t>, timerCount>   timerCalls{};
+    std::array<std::atomic<std::uint64_t>, timerCount>   timerNanos{};
+};
+
+[[nodiscard]] Slot &
+local();
+
+inline void
+bump(std::atomic<std::uint64_t> &value, std::uint64_t n) {
+    value.store(value.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+}
+
+} // namespace detail
+
+/***
+ * Add to one of the calling thread's counters.
+ * @param counter the counter to increment
+ * @param n the amount to add
+ */
+inline void
+add(Counter counter, std::uint64_t n = 1) {
+    if constexpr (enabled) {
+        detail::bump(detail::local().counters[static_cast<std::size_t>(counter)], n);
+    }
+}
+
+/***
+ * Raise one of the calling thread's gauges to the given value if it is larger than the current
+ * value.
+ * @param gauge the gauge to update
+ * @param value the observed value
+ */
+inline void
+observe(Gauge gauge, std::uint64_t value) {
+    if constexpr (enabled) {
+        auto &slot = detail::local().gauges[static_cast<std::size_t>(gauge)];
+        if (slot.load(std::memory_order_relaxed) < value) {
+            slot.store(value, std::memory_order_relaxed);
+        }
+    }
+}
+
+/***
+ * Record one timed interval against the calling thread's timer.
+ * @param timer the timer to record against
+ * @param nanos the duration of the interval in nanoseconds
+ */
+inline void
+record(Timer timer, std::uint64_t nanos) {
+    if constexpr (enabled) {
+        auto &slot = detail::local();
+        detail::bump(slot.timerCalls[static_cast<std::size_t>(timer)], 1);
+        detail::bump(slot.timerNanos[static_cast<std::size_t>(timer)], nanos);
+    }
+}
+
+/***
+ * @returns the sum of all threads' counters, or an all-zero Snapshot if instrumentation is
+ * disabled
+ */
+[[nodiscard]] Snapshot
+snapshot();
+
+/***
+ * Zero every thread's counters. Intended to be called while no other thread is recording.
+ */
+void
+reset();
+
+/***
+ * Take a snapshot and write it to the given stream as JSON.
+ * @param os the stream to write to
+ */
+void
+dumpJson(std::ostream &os);
+
+/***
+ * Records the lifetime of this object against a Timer.
+ */
+class ScopedTimer {
+public:
+    explicit ScopedTimer(Timer timer)
+        : timer_{timer} {
+        if constexpr (enabled) start_ = std::chrono::steady_clock::now();
+    }
+
+    ScopedTimer(const ScopedTimer &) = delete;
+
+    ~ScopedTimer() {
+        if constexpr (enabled) {
+            auto elapsed = std::chrono::steady_clock::now() - start_;
+            record(
+                timer_,
+                std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+        }
+    }
+
+private:
+    Timer                                 timer_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+/***
+ * A stateless allocator that counts its allocations in Counter::Allocations and
+ * Counter::AllocatedBytes. It behaves exactly like std::allocator when instrumentation is
+ * disabled.
+ */
+template<typename T>
+class Allocator {
+public:
+    using value_type = T;
+
+    Allocator() = default;
+
+    template<typename U>
+    Allocator(const Allocator<U> &) noexcept {}
+
+    [[nodiscard]] T *
+    allocate(std::size_t n) {
+        add(Counter::Allocations);
+        add(Counter::AllocatedBytes, n * sizeof(T));
+        return std::allocator<T>{}.allocate(n);
+    }
+
+    void
+    deallocate(T *ptr, std::size_t n) noexcept {
+        std::allocator<T>{}.deallocate(ptr, n);
+    }
+
+    template<typename U>
+    bool
+    operator==(const Allocator<U> &) const noexcept {
+        return true;
+    }
+
+    template<typename U>
+    bool
+    operator!=(const Allocator<U> &) const noexcept {
+        return false;
+    }
+};
+
+} // namespace Chess::Stats
+
+#endif // PORTAL_CHESS_INCLUDE_STATS_H
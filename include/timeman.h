@@ -0,0 +1,111 @@
+//
+// Created by taylor-santos on 10/19/2026 at 04:05.
+//
+
+#ifndef PORTAL_CHESS_INCLUDE_TIMEMAN_H
+#define PORTAL_CHESS_INCLUDE_TIMEMAN_H
+
+#include <chrono>
+#include <cstddef>
+#include <optional>
+
+#include "movegen.h"
+
+namespace Chess {
+
+struct TimeControl {
+    // The time left on the side to move's clock.
+    std::chrono::milliseconds remaining{0};
+
+    // The time added to the clock after each move.
+    std::chrono::milliseconds increment{0};
+
+    // The number of moves to make before the clock is next topped up, or 0 if the remaining time
+    // must last the rest of the game.
+    int movesToGo = 0;
+};
+
+/***
+ * Decides how long to think about one move. The clock is split into an optimum time, which a
+ * normal search aims for, and a maximum time, which no search may exceed. Between iterations the
+ * optimum is scaled by how settled the search looks: it is extended while the best move keeps
+ * changing or the score has just dropped, and shortened once the same move has been best for
+ * several iterations. A forced move is played as soon as one iteration is done.
+ */
+class TimeManager {
+public:
+    using Duration = std::chrono::steady_clock::duration;
+
+    // Kept back from every allocation to cover communication and scheduling delays.
+    static constexpr std::chrono::milliseconds overhead{20};
+
+    // The number of moves a clock with no movesToGo is divided over.
+    static constexpr int expectedMovesLeft = 30;
+
+    // A score drop from one iteration to the next of at least this many centipawns is a fail-low.
+    static constexpr int failLowMargin = 25;
+
+    // The number of consecutive iterations with the same best move after which it is easy.
+    static constexpr int easyMoveIterations = 6;
+
+    /***
+     * Allocate time for one move.
+     * @param control the side to move's clock
+     */
+    explicit TimeManager(const TimeControl &control);
+
+    /***
+     * @returns the time a search with a settled best move should take
+     */
+    [[nodiscard]] Duration
+    optimum() const;
+
+    /***
+     * @returns the time no search may exceed
+     */
+    [[nodiscard]] Duration
+    maximum() const;
+
+    /***
+     * Record the result of a completed iteration.
+     * @param best the best move found by the iteration
+     * @param score the score of the best move
+     * @param legalMoves the number of legal moves in the position being searched
+     */
+    void
+    iterationDone(const BasicMove &best, int score, std::size_t legalMoves);
+
+    /***
+     * @param elapsed the time spent searching so far
+     * @returns true if another iteration should not be started
+     */
+    [[nodiscard]] bool
+    shouldStop(Duration elapsed) const;
+
+    /***
+     * @param elapsed the time spent searching so far
+     * @returns true if the search must stop now, even partway through an iteration
+     */
+    [[nodiscard]] bool
+    outOfTime(Duration elapsed) const;
+
+    /***
+     * @returns the factor the optimum time is currently scaled by
+     */
+    [[nodiscard]] double
+    scale() const;
+
+private:
+    Duration                 optimum_;
+    Duration                 maximum_;
+    std::optional<BasicMove> best_;
+    int                      score_;
+    int                      stableIterations_;
+    double                   instability_;
+    bool                     failedLow_;
+    bool                     onlyMove_;
+};
+
+} // namespace Chess
+
+#endif // PORTAL_CHESS_INCLUDE_TIMEMAN_H
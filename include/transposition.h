@@ -0,0 +1,113 @@
+//
+// Created by taylor-santos on 10/19/2026 at 04:38.
+//
+
+#ifndef PORTAL_CHESS_INCLUDE_TRANSPOSITION_H
+#define PORTAL_CHESS_INCLUDE_TRANSPOSITION_H
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "movegen.h"
+
+namespace Chess {
+
+/***
+ * A fixed-size hash table of search results, indexed by position hash. Each slot holds one entry;
+ * a new entry replaces the old one unless the old one is from the current search and was searched
+ * deeper. Entries outlive the search that stored them, so a later search of the same or a
+ * following position starts from everything learned before.
+ */
+class TranspositionTable {
+public:
+    // How a stored score relates to the position's true score.
+    enum class Bound : std::uint8_t {
+        Exact, // the score is exact
+        Lower, // the search failed high: the true score is at least this
+        Upper, // the search failed low: the true score is at most this
+    };
+
+    struct Hit {
+        int                      score;
+        int                      depth;
+        Bound                    bound;
+        std::optional<BasicMove> move;
+    };
+
+    /***
+     * Allocate an empty table.
+     * @param entries the number of entries to hold, rounded down to a power of two
+     * @throws std::invalid_argument if entries is zero
+     */
+    explicit TranspositionTable(std::size_t entries);
+
+    /***
+     * @param key the hash of a position
+     * @returns the entry stored for the position, or an empty std::optional if there is none
+     */
+    [[nodiscard]] std::optional<Hit>
+    probe(std::uint64_t key) const;
+
+    /***
+     * Store a search result, unless the slot holds a deeper result from the current search.
+     * @param key the hash of the position
+     * @param depth the depth the position was searched to
+     * @param score the score found
+     * @param bound how the score relates to the true score
+     * @param move the best move found, if any
+     */
+    void
+    store(
+        std::uint64_t                   key,
+        int                             depth,
+        int                             score,
+        Bound                           bound,
+        const std::optional<BasicMove> &move);
+
+    /***
+     * Start a new search. Entries from earlier searches are kept, but can be replaced by any entry
+     * from this one.
+     */
+    void
+    newSearch();
+
+    /***
+     * Remove every entry. This starts a new epoch, and entries stored in an earlier epoch are
+     * ignored, so the table is only actually wiped once every 65535 calls, when the epoch wraps.
+     */
+    void
+    clear();
+
+    /***
+     * @returns the number of entries the table can hold
+     */
+    [[nodiscard]] std::size_t
+    size() const;
+
+private:
+    // 16 bytes: the index comes from the low bits of the key, so only the high half is stored.
+    struct Entry {
+        std::uint32_t check;
+        std::int32_t  score;
+        std::int8_t   depth;
+        std::int8_t   from;
+        std::int8_t   to;
+        std::uint8_t  promotion;
+        Bound         bound;
+        std::uint8_t  generation;
+        std::uint16_t epoch; // 0 in an entry that has never been stored to
+    };
+
+    [[nodiscard]] bool
+    live(const Entry &entry) const;
+
+    std::vector<Entry> entries_;
+    std::uint8_t       generation_;
+    std::uint16_t      epoch_;
+};
+
+} // namespace Chess
+
+#endif // PORTAL_CHESS_INCLUDE_TRANSPOSITION_H
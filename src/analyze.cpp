@@ -0,0 +1,105 @@
+//
+// Created by taylor-santos on 10/19/2026 at 01:20.
+//
+// Analyzes a stream of games, one per line, with a fixed-depth or fixed-node search, and writes
+// each result on its own line in input order. See parseGame() for the input format.
+//
+// Usage: portal_chess_analyze [--depth N] [--nodes N] [--threads N] [--window N] [input [output]]
+//
+
+#include "pipeline.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+
+using namespace Chess;
+
+static void
+usage(const char *name) {
+    std::fprintf(
+        stderr,
+        "Usage: %s [--depth N] [--nodes N] [--threads N] [--window N] [input [output]]\n",
+        name);
+}
+
+int
+main(int argc, char *argv[]) {
+    AnalysisOptions options;
+    options.limits.depth = 4;
+    options.threads      = std::max(1U, std::thread::hardware_concurrency());
+    options.window       = 0;
+
+    std::vector<std::string> files;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg.rfind("--", 0) != 0) {
+            files.push_back(arg);
+            continue;
+        }
+        if (i + 1 == argc) {
+            usage(argv[0]);
+            return 1;
+        }
+        try {
+            auto value = std::stoull(argv[++i]);
+            if (arg == "--depth") {
+                options.limits.depth = static_cast<int>(std::min<unsigned long long>(value, 64));
+            } else if (arg == "--nodes") {
+                options.limits.nodes = value;
+            } else if (arg == "--threads" && value > 0) {
+                options.threads = static_cast<unsigned>(value);
+            } else if (arg == "--window" && value > 0) {
+                options.window = static_cast<std::size_t>(value);
+            } else {
+                usage(argv[0]);
+                return 1;
+            }
+        } catch (const std::exception &) {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+    if (files.size() > 2) {
+        usage(argv[0]);
+        return 1;
+    }
+    // Enough in flight that no worker waits for the writer while one slow game is being searched.
+    if (options.window == 0) options.window = options.threads * 64;
+
+    std::ifstream inFile;
+    std::ofstream outFile;
+    if (!files.empty()) {
+        inFile.open(files[0]);
+        if (!inFile) {
+            std::fprintf(stderr, "Cannot open %s for reading\n", files[0].c_str());
+            return 1;
+        }
+    }
+    if (files.size() == 2) {
+        outFile.open(files[1]);
+        if (!outFile) {
+            std::fprintf(stderr, "Cannot open %s for writing\n", files[1].c_str());
+            return 1;
+        }
+    }
+    std::istream &in  = files.empty() ? std::cin : inFile;
+    std::ostream &out = files.size() == 2 ? outFile : std::cout;
+
+    std::ios::sync_with_stdio(false);
+    auto start   = std::chrono::steady_clock::now();
+    auto count   = analyze(in, out, options);
+    auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::fprintf(
+        stderr,
+        "%zu games in %.2f s (%.1f games/s) on %u threads\n",
+        count,
+        seconds,
+        seconds > 0 ? static_cast<double>(count) / seconds : 0.0,
+        options.threads);
+    return 0;
+}
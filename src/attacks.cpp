@@ -0,0 +1,101 @@
+//
+// Created by taylor-santos on 10/18/2026 at 14:40.
+//
+
+#include "attacks.h"
+
+#include <stdexcept>
+#include <string>
+
+#include "board.h"
+
+namespace Chess {
+
+int
+squareOf(Coord coord) {
+    return (coord.rank - 1) * 8 + (coord.file - 1);
+}
+
+Coord
+coordOf(int square) {
+    return {static_cast<File>(square % 8 + 1), static_cast<Rank>(square / 8 + 1)};
+}
+
+Bitboard
+bitOf(Coord coord) {
+    return Bitboard{1} << squareOf(coord);
+}
+
+template class BasicAttackMap<StandardGeometry>;
+
+AttackMap::AttackMap(const Board &board) {
+    for (int square = 0; square < 64; square++) {
+        if (auto piece = board.at(coordOf(square))) place(square, **piece);
+    }
+    rebuild();
+}
+
+void
+AttackMap::addPiece(Coord coord, Piece piece) {
+    addPiece(squareOf(coord), piece);
+}
+
+void
+AttackMap::removePiece(Coord coord) {
+    removePiece(squareOf(coord));
+}
+
+void
+AttackMap::movePiece(Coord from, Coord to) {
+    movePiece(squareOf(from), squareOf(to));
+}
+
+std::optional<Piece>
+AttackMap::at(Coord coord) const {
+    return at(squareOf(coord));
+}
+
+Bitboard
+AttackMap::attacksFrom(Coord coord) const {
+    return attacksFrom(squareOf(coord));
+}
+
+Bitboard
+AttackMap::attackersOf(Coord coord, Color color) const {
+    return attackersOf(squareOf(coord), color);
+}
+
+Bitboard
+AttackMap::defendersOf(Coord coord) const {
+    return defendersOf(squareOf(coord));
+}
+
+bool
+AttackMap::isAttacked(Coord coord, Color color) const {
+    return isAttacked(squareOf(coord), color);
+}
+
+std::optional<Coord>
+AttackMap::portalPartner(Coord coord) const {
+    auto partner = portalPartner(squareOf(coord));
+    return partner < 0 ? std::nullopt : std::optional(coordOf(partner));
+}
+
+std::optional<Coord>
+AttackMap::step(Coord from, Step step) const {
+    auto to = BasicAttackMap::step(squareOf(from), step);
+    return to < 0 ? std::nullopt : std::optional(coordOf(to));
+}
+
+std::optional<Coord>
+AttackMap::step(Coord from, int files, int ranks) const {
+    for (int index = 0; index < StepCount; index++) {
+        if (stepOffsets[index].files == files && stepOffsets[index].ranks == ranks) {
+            return step(from, static_cast<Step>(index));
+        }
+    }
+    throw std::invalid_argument(
+        "(" + std::to_string(files) + ", " + std::to_string(ranks) + ") is not a single step");
+}
+
+} // namespace Chess
@@ -0,0 +1,477 @@
+//
+// Created by taylor-santos on 10/19/2026 at 02:48.
+//
+
+#include "audio.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
+
+#ifdef PORTAL_CHESS_HAVE_STB_VORBIS
+#define STB_VORBIS_HEADER_ONLY
+#include "stb_vorbis.c"
+#endif
+
+namespace Chess::Audio {
+
+namespace {
+
+constexpr std::size_t wavHeaderBytes = 44;
+
+std::uint32_t
+readLE(const std::uint8_t *bytes, int count) {
+    std::uint32_t value = 0;
+    for (int i = count - 1; i >= 0; i--) {
+        value = value << 8U | bytes[i];
+    }
+    return value;
+}
+
+void
+writeLE(std::uint8_t *bytes, std::uint32_t value, int count) {
+    for (int i = 0; i < count; i++) {
+        bytes[i] = static_cast<std::uint8_t>(value >> (8 * i));
+    }
+}
+
+bool
+hasMagic(const std::vector<std::uint8_t> &data, std::size_t offset, const char *magic) {
+    auto length = std::strlen(magic);
+    return data.size() >= offset + length && std::memcmp(data.data() + offset, magic, length) == 0;
+}
+
+// A 16-bit PCM WAV header for the given format, followed by dataBytes of samples.
+std::array<std::uint8_t, wavHeaderBytes>
+wavHeader(unsigned channels, unsigned sampleRate, std::uint32_t dataBytes) {
+    std::array<std::uint8_t, wavHeaderBytes> header{};
+    std::memcpy(header.data(), "RIFF", 4);
+    writeLE(header.data() + 4, 36 + dataBytes, 4);
+    std::memcpy(header.data() + 8, "WAVEfmt ", 8);
+    writeLE(header.data() + 16, 16, 4);
+    writeLE(header.data() + 20, 1, 2);
+    writeLE(header.data() + 22, channels, 2);
+    writeLE(header.data() + 24, sampleRate, 4);
+    writeLE(header.data() + 28, sampleRate * channels * 2, 4);
+    writeLE(header.data() + 32, channels * 2, 2);
+    writeLE(header.data() + 34, 16, 2);
+    std::memcpy(header.data() + 36, "data", 4);
+    writeLE(header.data() + 40, dataBytes, 4);
+    return header;
+}
+
+[[noreturn]] void
+invalidWav(const char *reason) {
+    throw std::runtime_error(std::string{"Invalid WAV data: "} + reason);
+}
+
+std::int16_t
+clip(std::int32_t sample) {
+    return static_cast<std::int16_t>(std::clamp<std::int32_t>(sample, INT16_MIN, INT16_MAX));
+}
+
+std::vector<std::uint8_t>
+readFile(const std::filesystem::path &path) {
+    std::ifstream file{path, std::ios::binary};
+    if (!file) throw std::runtime_error("Cannot open " + path.string());
+    return {std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+}
+
+// Gains are applied as fixed-point integers with this many fractional bits.
+constexpr int gainBits = 8;
+
+static_assert(
+    Mixer::maxVoices * (INT16_MAX + 1) * static_cast<std::int64_t>(Mixer::maxGain) <= INT32_MAX,
+    "A full mix at maximum gain must fit in the 32-bit accumulator");
+
+} // namespace
+
+std::size_t
+Sound::frames() const {
+    return channels ? samples.size() / channels : 0;
+}
+
+Sound
+decodeWav(const std::vector<std::uint8_t> &data) {
+    if (!hasMagic(data, 0, "RIFF") || !hasMagic(data, 8, "WAVE")) {
+        invalidWav("not a RIFF WAVE file");
+    }
+
+    unsigned            format = 0, channels = 0, sampleRate = 0, bits = 0;
+    const std::uint8_t *samples = nullptr;
+    std::size_t         bytes   = 0;
+    for (std::size_t offset = 12; offset + 8 <= data.size();) {
+        auto *chunk = data.data() + offset;
+        auto  size  = std::min<std::size_t>(readLE(chunk + 4, 4), data.size() - offset - 8);
+        if (std::memcmp(chunk, "fmt ", 4) == 0) {
+            if (size < 16) invalidWav("fmt chunk is too short");
+            format     = readLE(chunk + 8, 2);
+            channels   = readLE(chunk + 10, 2);
+            sampleRate = readLE(chunk + 12, 4);
+            bits       = readLE(chunk + 22, 2);
+            // WAVE_FORMAT_EXTENSIBLE stores the real format at the start of its subformat GUID.
+            if (format == 0xFFFE) {
+                if (size < 26) invalidWav("fmt chunk is too short");
+                format = readLE(chunk + 32, 2);
+            }
+        } else if (std::memcmp(chunk, "data", 4) == 0) {
+            samples = chunk + 8;
+            bytes   = size;
+        }
+        // Chunks are padded to an even size.
+        offset += 8 + size + (size & 1U);
+    }
+    if (!channels || !sampleRate) invalidWav("missing or empty fmt chunk");
+    if (!samples) invalidWav("missing data chunk");
+
+    bool isInt   = format == 1 && (bits == 8 || bits == 16 || bits == 24 || bits == 32);
+    bool isFloat = format == 3 && bits == 32;
+    if (!isInt && !isFloat) invalidWav("unsupported sample format");
+
+    Sound sound{channels, sampleRate, {}};
+    auto  width = bits / 8;
+    auto  count = bytes / width / channels * channels;
+    sound.samples.reserve(count);
+    for (std::size_t i = 0; i < count; i++) {
+        auto *sample = samples + i * width;
+        if (isFloat) {
+            float value;
+            std::memcpy(&value, sample, 4);
+            // Out of range samples, including infinities, are clipped before rounding, since
+            // rounding a value too large for a long gives an unspecified result.
+            if (std::isnan(value)) invalidWav("sample is not a number");
+            value = std::clamp(value, -1.0f, 1.0f);
+            sound.samples.push_back(static_cast<std::int16_t>(std::lround(value * 32767)));
+        } else if (bits == 8) {
+            sound.samples.push_back(static_cast<std::int16_t>((sample[0] - 128) * 256));
+        } else {
+            // Keep the most significant 16 bits of wider samples.
+            auto value = readLE(sample + width - 2, 2);
+            sound.samples.push_back(static_cast<std::int16_t>(value));
+        }
+    }
+    return sound;
+}
+
+Sound
+decodeOgg(const std::vector<std::uint8_t> &data) {
+#ifdef PORTAL_CHESS_HAVE_STB_VORBIS
+    int    channels = 0, sampleRate = 0;
+    short *output = nullptr;
+    int    frames = stb_vorbis_decode_memory(
+        data.data(),
+        static_cast<int>(data.size()),
+        &channels,
+        &sampleRate,
+        &output);
+    if (frames < 0 || channels <= 0) {
+        std::free(output);
+        throw std::runtime_error("Invalid OGG Vorbis data");
+    }
+    Sound sound{
+        static_cast<unsigned>(channels),
+        static_cast<unsigned>(sampleRate),
+        {output, output + static_cast<std::size_t>(frames) * channels}};
+    std::free(output);
+    return sound;
+#else
+    (void)data;
+    throw std::runtime_error("OGG Vorbis support was not built in (stb_vorbis.c was not found)");
+#endif
+}
+
+Sound
+decode(const std::vector<std::uint8_t> &data) {
+    if (hasMagic(data, 0, "RIFF")) return decodeWav(data);
+    if (hasMagic(data, 0, "OggS")) return decodeOgg(data);
+    throw std::runtime_error("Unrecognized audio format");
+}
+
+std::vector<std::uint8_t>
+encodeWav(const Sound &sound) {
+    auto dataBytes = static_cast<std::uint32_t>(sound.samples.size() * 2);
+    auto header    = wavHeader(sound.channels, sound.sampleRate, dataBytes);
+
+    std::vector<std::uint8_t> data(header.begin(), header.end());
+    data.resize(wavHeaderBytes + dataBytes);
+    for (std::size_t i = 0; i < sound.samples.size(); i++) {
+        auto sample = static_cast<std::uint16_t>(sound.samples[i]);
+        writeLE(data.data() + wavHeaderBytes + 2 * i, sample, 2);
+    }
+    return data;
+}
+
+Sound
+resample(const Sound &sound, unsigned sampleRate) {
+    if (!sampleRate || !sound.sampleRate || !sound.channels) {
+        throw std::invalid_argument("Cannot resample a sound with no channels or sample rate");
+    }
+    auto frames = sound.frames();
+    auto sample = [&](std::size_t frame, unsigned channel) -> std::int32_t {
+        return sound.samples[frame * sound.channels + std::min(channel, sound.channels - 1)];
+    };
+
+    Sound result{outputChannels, sampleRate, {}};
+    if (frames == 0) return result;
+
+    auto outFrames = static_cast<std::size_t>(
+        (static_cast<std::uint64_t>(frames) * sampleRate + sound.sampleRate - 1) /
+        sound.sampleRate);
+    result.samples.reserve(outFrames * outputChannels);
+    for (std::size_t i = 0; i < outFrames; i++) {
+        // The source position of this frame, in 1/sampleRate steps.
+        auto position = static_cast<std::uint64_t>(i) * sound.sampleRate;
+        auto frame    = static_cast<std::size_t>(position / sampleRate);
+        auto next     = std::min(frame + 1, frames - 1);
+        auto fraction = static_cast<std::int64_t>(position % sampleRate);
+        for (unsigned channel = 0; channel < outputChannels; channel++) {
+            std::int64_t a = sample(frame, channel), b = sample(next, channel);
+            result.samples.push_back(
+                static_cast<std::int16_t>(a + (b - a) * fraction / sampleRate));
+        }
+    }
+    return result;
+}
+
+SoundBank::SoundBank(unsigned sampleRate)
+    : sampleRate_{sampleRate} {
+    if (!sampleRate) throw std::invalid_argument("SoundBank sample rate must be nonzero");
+}
+
+SoundId
+SoundBank::add(const std::string &name, const Sound &sound) {
+    if (ids_.count(name)) throw std::invalid_argument("Duplicate sound \"" + name + "\"");
+    auto id = static_cast<SoundId>(sounds_.size());
+    sounds_.push_back(std::make_unique<const Sound>(resample(sound, sampleRate_)));
+    ids_.emplace(name, id);
+    return id;
+}
+
+SoundId
+SoundBank::load(const std::filesystem::path &path) {
+    Sound sound;
+    try {
+        sound = decode(readFile(path));
+    } catch (const std::runtime_error &e) {
+        throw std::runtime_error(path.string() + ": " + e.what());
+    }
+    return add(path.stem().string(), sound);
+}
+
+std::size_t
+SoundBank::loadDirectory(const std::filesystem::path &directory) {
+    std::vector<std::filesystem::path> paths;
+    for (auto &entry : std::filesystem::directory_iterator{directory}) {
+        auto extension = entry.path().extension();
+        if (!entry.is_regular_file()) continue;
+        // OGG files are loaded even without OGG support, so that load() reports them.
+        if (extension == ".wav" || extension == ".ogg") {
+            paths.push_back(entry.path());
+        }
+    }
+    std::sort(paths.begin(), paths.end());
+    for (auto &path : paths) {
+        load(path);
+    }
+    return paths.size();
+}
+
+std::optional<SoundId>
+SoundBank::find(std::string_view name) const {
+    auto it = ids_.find(std::string{name});
+    if (it == ids_.end()) return std::nullopt;
+    return it->second;
+}
+
+const Sound &
+SoundBank::operator[](SoundId id) const {
+    return *sounds_.at(id);
+}
+
+std::size_t
+SoundBank::size() const {
+    return sounds_.size();
+}
+
+unsigned
+SoundBank::sampleRate() const {
+    return sampleRate_;
+}
+
+Mixer::Mixer(const SoundBank &bank)
+    : bank_{bank}
+    , voices_{}
+    , voiceCount_{0} {}
+
+bool
+Mixer::play(SoundId id, float gain) {
+    // Written so that NaN also becomes 0.
+    gain       = gain > 0 ? std::min(gain, maxGain) : 0.0f;
+    auto fixed = static_cast<int>(std::lround(gain * (1 << gainBits)));
+    return commands_.tryPush({Command::Kind::Play, &bank_[id], fixed});
+}
+
+bool
+Mixer::stopAll() {
+    return commands_.tryPush({Command::Kind::StopAll, nullptr, 0});
+}
+
+void
+Mixer::render(std::int16_t *samples, std::size_t frames) {
+    while (auto command = commands_.tryPop()) {
+        if (command->kind == Command::Kind::StopAll) {
+            voiceCount_ = 0;
+            continue;
+        }
+        Voice voice{command->sound, 0, command->gain};
+        if (voiceCount_ < maxVoices) {
+            voices_[voiceCount_++] = voice;
+        } else {
+            auto oldest = std::max_element(
+                voices_.begin(),
+                voices_.end(),
+                [](const Voice &a, const Voice &b) { return a.position < b.position; });
+            *oldest = voice;
+        }
+    }
+
+    // Mix in chunks through a fixed-size accumulator so that rendering never allocates.
+    std::array<std::int32_t, 512 * outputChannels> mix;
+    for (std::size_t done = 0; done < frames;) {
+        auto chunk = std::min(frames - done, mix.size() / outputChannels);
+        std::fill_n(mix.begin(), chunk * outputChannels, 0);
+        for (std::size_t v = 0; v < voiceCount_; v++) {
+            auto &voice = voices_[v];
+            auto *from  = voice.sound->samples.data() + voice.position * outputChannels;
+            auto  count = std::min(chunk, voice.sound->frames() - voice.position);
+            for (std::size_t i = 0; i < count * outputChannels; i++) {
+                mix[i] += from[i] * voice.gain >> gainBits;
+            }
+            voice.position += count;
+        }
+        for (std::size_t i = 0; i < chunk * outputChannels; i++) {
+            samples[done * outputChannels + i] = clip(mix[i]);
+        }
+        done += chunk;
+
+        // Drop finished voices.
+        for (std::size_t v = 0; v < voiceCount_;) {
+            if (voices_[v].position == voices_[v].sound->frames()) {
+                voices_[v] = voices_[--voiceCount_];
+            } else {
+                v++;
+            }
+        }
+    }
+}
+
+std::size_t
+Mixer::activeVoices() const {
+    return voiceCount_;
+}
+
+unsigned
+Mixer::sampleRate() const {
+    return bank_.sampleRate();
+}
+
+NullOutput::NullOutput(unsigned sampleRate, bool realtime)
+    : sampleRate_{sampleRate}
+    , realtime_{realtime}
+    , frames_{0} {
+    if (!sampleRate) throw std::invalid_argument("Output sample rate must be nonzero");
+}
+
+unsigned
+NullOutput::sampleRate() const {
+    return sampleRate_;
+}
+
+void
+NullOutput::write(const std::int16_t *, std::size_t frames) {
+    auto written = frames_.load(std::memory_order_relaxed);
+    if (realtime_) {
+        auto now = std::chrono::steady_clock::now();
+        if (written == 0) start_ = now;
+        // Like a device, accept a block once the blocks before it would have finished playing.
+        auto played = std::chrono::duration<double>(static_cast<double>(written) / sampleRate_);
+        auto playedUntil =
+            start_ + std::chrono::duration_cast<std::chrono::steady_clock::duration>(played);
+        if (playedUntil > now) {
+            std::this_thread::sleep_until(playedUntil);
+        } else {
+            // Fell behind, e.g. the thread was descheduled: restart the clock rather than
+            // rushing through blocks to catch up.
+            start_ = now - (playedUntil - start_);
+        }
+    }
+    frames_.store(written + frames, std::memory_order_relaxed);
+}
+
+std::uint64_t
+NullOutput::framesWritten() const {
+    return frames_.load(std::memory_order_relaxed);
+}
+
+FileOutput::FileOutput(const std::filesystem::path &path, unsigned sampleRate, bool realtime)
+    : file_{path, std::ios::binary}
+    , clock_{sampleRate, realtime} {
+    if (!file_) throw std::runtime_error("Cannot create " + path.string());
+    auto header = wavHeader(outputChannels, sampleRate, 0);
+    file_.write(reinterpret_cast<const char *>(header.data()), header.size());
+}
+
+FileOutput::~FileOutput() {
+    auto dataBytes = static_cast<std::uint32_t>(clock_.framesWritten() * outputChannels * 2);
+    auto header    = wavHeader(outputChannels, clock_.sampleRate(), dataBytes);
+    file_.seekp(0);
+    file_.write(reinterpret_cast<const char *>(header.data()), header.size());
+}
+
+unsigned
+FileOutput::sampleRate() const {
+    return clock_.sampleRate();
+}
+
+void
+FileOutput::write(const std::int16_t *samples, std::size_t frames) {
+    std::array<std::uint8_t, 2> bytes;
+    for (std::size_t i = 0; i < frames * outputChannels; i++) {
+        writeLE(bytes.data(), static_cast<std::uint16_t>(samples[i]), 2);
+        file_.write(reinterpret_cast<const char *>(bytes.data()), bytes.size());
+    }
+    clock_.write(samples, frames);
+}
+
+std::uint64_t
+FileOutput::framesWritten() const {
+    return clock_.framesWritten();
+}
+
+AudioThread::AudioThread(Mixer &mixer, std::unique_ptr<Output> output, std::size_t blockFrames)
+    : output_{std::move(output)}
+    , stopping_{false} {
+    if (!output_) throw std::invalid_argument("AudioThread needs an Output");
+    if (!blockFrames) throw std::invalid_argument("AudioThread block size must be nonzero");
+    if (output_->sampleRate() != mixer.sampleRate()) {
+        throw std::invalid_argument("Output and SoundBank sample rates differ");
+    }
+    // The block is allocated here, so the thread itself never allocates.
+    block_.resize(blockFrames * outputChannels);
+    thread_ = std::thread{[this, &mixer, blockFrames] {
+        while (!stopping_.load(std::memory_order_relaxed)) {
+            mixer.render(block_.data(), blockFrames);
+            output_->write(block_.data(), blockFrames);
+        }
+    }};
+}
+
+AudioThread::~AudioThread() {
+    stopping_.store(true, std::memory_order_relaxed);
+    thread_.join();
+}
+
+} // namespace Chess::Audio
@@ -6,22 +6,109 @@
 
 #include <sstream>
 #include <array>
+#include <atomic>
 
 #include "coord.h"
+#include "piece.h"
+#include "stats.h"
 
 namespace Chess {
 
 template<typename T, int N>
 using sqr_array = std::array<std::array<T, N>, N>;
 
+// Zobrist keys for each (square, piece type, piece color) triple, generated with splitmix64.
+class ZobristKeys {
+public:
+    constexpr ZobristKeys()
+        : keys_{} {
+        std::uint64_t state = 0x5d1c0de5eed0f00dULL;
+        for (auto &square : keys_) {
+            for (auto &key : square) {
+                state += 0x9e3779b97f4a7c15ULL;
+                std::uint64_t z = state;
+                z               = (z ^ (z >> 30U)) * 0xbf58476d1ce4e5b9ULL;
+                z               = (z ^ (z >> 27U)) * 0x94d049bb133111ebULL;
+                key             = z ^ (z >> 31U);
+            }
+        }
+    }
+
+    [[nodiscard]] std::uint64_t
+    operator()(Coord coord, const Piece &piece) const {
+        auto square = (coord.rank - 1) * 8 + (coord.file - 1);
+        auto kind   = static_cast<int>(piece.type) * 2 + static_cast<int>(piece.color);
+        return keys_[square][kind];
+    }
+
+private:
+    std::array<std::array<std::uint64_t, 14>, 64> keys_;
+};
+
+static constexpr ZobristKeys zobrist;
+
+static int
+squareIndex(Coord coord) {
+    return (coord.rank - 1) * 8 + (coord.file - 1);
+}
+
+// Allocate a Board node through the instrumented allocator and count it once it has been
+// successfully constructed.
+template<typename T, typename... Args>
+static std::shared_ptr<T>
+allocateNode(Args &&...args) {
+    auto ptr = std::allocate_shared<T>(Stats::Allocator<T>{}, std::forward<Args>(args)...);
+    Stats::add(Stats::Counter::BoardNodes);
+    return ptr;
+}
+
+// Placed at the top of every at() override to measure how many history-chain nodes a single
+// top-level lookup visits. Only the outermost probe on a thread records the result.
+class ChainDepthProbe {
+public:
+    ChainDepthProbe() {
+        if constexpr (Stats::enabled) {
+            depth_++;
+            visited_++;
+        }
+    }
+
+    ChainDepthProbe(const ChainDepthProbe &) = delete;
+
+    ~ChainDepthProbe() {
+        if constexpr (Stats::enabled) {
+            if (--depth_ == 0) {
+                Stats::add(Stats::Counter::AtCalls);
+                Stats::add(Stats::Counter::AtDepth, visited_);
+                Stats::observe(Stats::Gauge::AtMaxDepth, visited_);
+                visited_ = 0;
+            }
+        }
+    }
+
+private:
+    static thread_local std::uint64_t depth_;
+    static thread_local std::uint64_t visited_;
+};
+
+thread_local std::uint64_t ChainDepthProbe::depth_   = 0;
+thread_local std::uint64_t ChainDepthProbe::visited_ = 0;
+
 class Board::InitialBoard : public Board {
 public:
-    explicit InitialBoard(std::vector<std::pair<Coord, incomplete_ptr<Piece>>> &pieces);
+    InitialBoard(
+        std::vector<std::pair<Coord, incomplete_ptr<Piece>>> &pieces,
+        std::size_t                                           historyBudget);
+
+    explicit InitialBoard(const Board &board);
 
     [[nodiscard]] std::optional<const Piece *>
     at(Coord coord) const override;
 
 private:
+    [[nodiscard]] std::size_t
+    edits(std::array<Edit, 2> &out) const override;
+
     class BoardState {
     public:
         explicit BoardState(sqr_array<incomplete_ptr<Piece>, 8> board);
@@ -42,9 +129,11 @@ public:
     at(Coord coord) const override;
 
 private:
-    const std::shared_ptr<const Board> board_;
-    const Coord                        coord_;
-    const incomplete_ptr<Piece>        piece_;
+    [[nodiscard]] std::size_t
+    edits(std::array<Edit, 2> &out) const override;
+
+    const Coord                 coord_;
+    const incomplete_ptr<Piece> piece_;
 };
 
 class Board::RemovedPiece : public Board {
@@ -55,8 +144,12 @@ public:
     at(Coord coord) const override;
 
 private:
-    const std::shared_ptr<const Board> board_;
-    const Coord                        coord_;
+    [[nodiscard]] std::size_t
+    edits(std::array<Edit, 2> &out) const override;
+
+    const Coord coord_;
+    // The removed piece, owned by an ancestor, so that edits() need not look it up.
+    const Piece *piece_;
 };
 
 class Board::MovedPiece : public Board {
@@ -67,39 +160,147 @@ public:
     at(Coord coord) const override;
 
 private:
-    const std::shared_ptr<const Board> board_;
-    const Coord                        from_;
-    const Coord                        to_;
+    [[nodiscard]] std::size_t
+    edits(std::array<Edit, 2> &out) const override;
+
+    const Coord from_;
+    const Coord to_;
+    // The moved piece, owned by an ancestor, so that edits() need not look it up.
+    const Piece *piece_;
 };
 
+// Kept on its own cache line so that the reference counts of branches owned by different threads,
+// which are allocated alongside them, never share a line.
+class alignas(64) Board::Branch : public Board {
+public:
+    explicit Branch(std::shared_ptr<const Board> board);
+
+    [[nodiscard]] std::optional<const Piece *>
+    at(Coord coord) const override;
+
+private:
+    [[nodiscard]] std::size_t
+    edits(std::array<Edit, 2> &out) const override;
+};
+
+Board::Board(std::shared_ptr<const Board> parent, std::size_t nodeBytes)
+    : parent_{std::move(parent)}
+    , depth_{parent_ ? parent_->depth_ + 1 : 0}
+    , historyBudget_{parent_ ? parent_->historyBudget_ : unlimitedHistory}
+    , historyBytes_{(parent_ ? parent_->historyBytes_ : 0) + nodeBytes}
+    , hash_{parent_ ? parent_->hash_ : 0} {}
+
+Board::~Board() {
+    // Releasing parent_ normally destroys every uniquely-owned ancestor recursively. Instead, take
+    // ownership of each such ancestor's parent before letting the ancestor go, so that it is
+    // destroyed with an empty parent_ and the recursion never goes deeper than one level.
+    //
+    // use_count() == 1 means no other shared_ptr owns the ancestor, and none can appear: the only
+    // weak_ptr to a Board is its own wptr_, which derive() locks through a reference to the Board,
+    // and an ancestor is only reachable through its children's parent_. The count is a relaxed
+    // load, so the acquire fence makes every access by threads that released the ancestor happen
+    // before its parent_ is taken.
+    auto parent = std::move(parent_);
+    while (parent && parent.use_count() == 1) {
+        std::atomic_thread_fence(std::memory_order_acquire);
+        // Every Board is created non-const by make() or derive(), so this cast is well-defined.
+        parent = std::move(const_cast<Board &>(*parent).parent_);
+    }
+}
+
 std::shared_ptr<const Board>
-Board::make(std::vector<std::pair<Coord, incomplete_ptr<Piece>>> pieces) {
-    auto ptr   = std::make_shared<InitialBoard>(pieces);
+Board::make(
+    std::vector<std::pair<Coord, incomplete_ptr<Piece>>> pieces,
+    std::size_t                                           historyBudget) {
+    auto ptr   = allocateNode<InitialBoard>(pieces, historyBudget);
     ptr->wptr_ = ptr;
     return ptr;
 }
 
+template<typename T, typename... Args>
 std::shared_ptr<const Board>
-Board::addPiece(Coord coord, incomplete_ptr<Piece> piece) const {
-    auto ptr   = std::make_shared<AddedPiece>(wptr_.lock(), coord, std::move(piece));
+Board::derive(Args &&...args) const {
+    auto ptr   = allocateNode<T>(wptr_.lock(), std::forward<Args>(args)...);
     ptr->wptr_ = ptr;
+    if (ptr->historyBytes_ > historyBudget_) {
+        return ptr->flatten();
+    }
     return ptr;
 }
 
+std::shared_ptr<const Board>
+Board::addPiece(Coord coord, incomplete_ptr<Piece> piece) const {
+    return derive<AddedPiece>(coord, std::move(piece));
+}
+
 std::shared_ptr<const Board>
 Board::removePiece(Coord coord) const {
-    auto ptr   = std::make_shared<RemovedPiece>(wptr_.lock(), coord);
-    ptr->wptr_ = ptr;
-    return ptr;
+    return derive<RemovedPiece>(coord);
 }
 
 std::shared_ptr<const Board>
 Board::movePiece(Coord from, Coord to) const {
-    auto ptr   = std::make_shared<MovedPiece>(wptr_.lock(), from, to);
+    return derive<MovedPiece>(from, to);
+}
+
+std::shared_ptr<const Board>
+Board::flatten() const {
+    auto ptr   = allocateNode<InitialBoard>(*this);
     ptr->wptr_ = ptr;
     return ptr;
 }
 
+std::shared_ptr<const Board>
+Board::branch() const {
+    return derive<Branch>();
+}
+
+bool
+Board::walkToCommonAncestor(
+    const Board                                    &from,
+    const Board                                    &to,
+    const std::function<void(const Board &, bool)> &visit) {
+    for (auto *a = &from, *b = &to; a != b;) {
+        bool  toSide = b->depth_ > a->depth_;
+        auto &deeper = toSide ? b : a;
+        if (!deeper->parent_) return false;
+        visit(*deeper, toSide);
+        deeper = deeper->parent_.get();
+    }
+    return true;
+}
+
+std::size_t
+Board::historyBytes() const {
+    return historyBytes_;
+}
+
+std::uint64_t
+Board::hash() const {
+    return hash_;
+}
+
+bool
+Board::operator==(const Board &other) const {
+    if (this == &other) return true;
+    if (hash_ != other.hash_) return false;
+    for (int file = A; file <= H; file++) {
+        for (int rank = _1; rank <= _8; rank++) {
+            Coord coord{static_cast<File>(file), static_cast<Rank>(rank)};
+            auto  piece1 = at(coord);
+            auto  piece2 = other.at(coord);
+            if (piece1.has_value() != piece2.has_value()) return false;
+            if (piece1 && **piece1 != **piece2) return false;
+        }
+    }
+    return true;
+}
+
+bool
+Board::operator!=(const Board &other) const {
+    return !(*this == other);
+}
+
 static sqr_array<incomplete_ptr<Piece>, 8>
 getPieces(std::vector<std::pair<Coord, incomplete_ptr<Piece>>> &pieces) {
     sqr_array<incomplete_ptr<Piece>, 8> board;
@@ -117,15 +318,59 @@ getPieces(std::vector<std::pair<Coord, incomplete_ptr<Piece>>> &pieces) {
     return board;
 }
 
-Board::InitialBoard::InitialBoard(std::vector<std::pair<Coord, incomplete_ptr<Piece>>> &pieces)
-    : board_{getPieces(pieces)} {}
+static sqr_array<incomplete_ptr<Piece>, 8>
+copyPieces(const Board &other) {
+    sqr_array<incomplete_ptr<Piece>, 8> board;
+    for (int file = A; file <= H; file++) {
+        for (int rank = _1; rank <= _8; rank++) {
+            if (auto piece = other.at({static_cast<File>(file), static_cast<Rank>(rank)})) {
+                board[file - 1][rank - 1] = std::make_unique<Piece>(**piece);
+            }
+        }
+    }
+    return board;
+}
+
+static std::uint64_t
+hashPieces(const Board &board) {
+    std::uint64_t hash = 0;
+    for (int file = A; file <= H; file++) {
+        for (int rank = _1; rank <= _8; rank++) {
+            Coord coord{static_cast<File>(file), static_cast<Rank>(rank)};
+            if (auto piece = board.at(coord)) hash ^= zobrist(coord, **piece);
+        }
+    }
+    return hash;
+}
+
+Board::InitialBoard::InitialBoard(
+    std::vector<std::pair<Coord, incomplete_ptr<Piece>>> &pieces,
+    std::size_t                                           historyBudget)
+    : Board{nullptr, sizeof(InitialBoard)}
+    , board_{getPieces(pieces)} {
+    historyBudget_ = historyBudget;
+    hash_          = hashPieces(*this);
+}
+
+Board::InitialBoard::InitialBoard(const Board &board)
+    : Board{nullptr, sizeof(InitialBoard)}
+    , board_{copyPieces(board)} {
+    historyBudget_ = board.historyBudget_;
+    hash_          = board.hash_;
+}
 
 std::optional<const Piece *>
 Board::InitialBoard::at(Coord coord) const {
+    ChainDepthProbe probe;
     auto &optPiece = board_(coord);
     return optPiece ? std::optional(optPiece.get()) : std::nullopt;
 }
 
+std::size_t
+Board::InitialBoard::edits(std::array<Edit, 2> &) const {
+    return 0;
+}
+
 Board::InitialBoard::BoardState::BoardState(sqr_array<incomplete_ptr<Piece>, 8> board)
     : board_{std::move(board)} {}
 
@@ -139,64 +384,111 @@ Board::AddedPiece::AddedPiece(
     std::shared_ptr<const Board> board,
     Coord                        coord,
     incomplete_ptr<Piece>        piece)
-    : board_{std::move(board)}
+    : Board{std::move(board), sizeof(AddedPiece) + sizeof(Piece)}
     , coord_{coord}
     , piece_{std::move(piece)} {
-    if (board_->at(coord)) {
+    if (parent_->at(coord)) {
         std::stringstream ss;
         ss << "Cannot add piece to " << coord << ": this space is occupied";
         throw invalid_piece(ss.str());
     }
+    hash_ ^= zobrist(coord_, *piece_);
 }
 
 std::optional<const Piece *>
 Board::AddedPiece::at(Coord coord) const {
-    return coord_ == coord ? piece_.get() : board_->at(coord);
+    ChainDepthProbe probe;
+    return coord_ == coord ? piece_.get() : parent_->at(coord);
+}
+
+std::size_t
+Board::AddedPiece::edits(std::array<Edit, 2> &out) const {
+    out[0] = {squareIndex(coord_), nullptr, piece_.get()};
+    return 1;
 }
 
 Board::RemovedPiece::RemovedPiece(std::shared_ptr<const Board> board, Coord coord)
-    : board_{std::move(board)}
-    , coord_{coord} {
-    if (!board_->at(coord)) {
+    : Board{std::move(board), sizeof(RemovedPiece)}
+    , coord_{coord}
+    , piece_{nullptr} {
+    auto piece = parent_->at(coord);
+    if (!piece) {
         std::stringstream ss;
         ss << "Cannot remove piece from " << coord << ": this space is empty";
         throw invalid_piece(ss.str());
     }
+    piece_ = *piece;
+    hash_ ^= zobrist(coord_, *piece_);
 }
 
 std::optional<const Piece *>
 Board::RemovedPiece::at(Coord coord) const {
-    return coord == coord_ ? std::nullopt : board_->at(coord);
+    ChainDepthProbe probe;
+    return coord == coord_ ? std::nullopt : parent_->at(coord);
+}
+
+std::size_t
+Board::RemovedPiece::edits(std::array<Edit, 2> &out) const {
+    out[0] = {squareIndex(coord_), piece_, nullptr};
+    return 1;
 }
 
 Board::MovedPiece::MovedPiece(std::shared_ptr<const Board> board, Coord from, Coord to)
-    : board_{std::move(board)}
+    : Board{std::move(board), sizeof(MovedPiece)}
     , from_{from}
-    , to_{to} {
-    if (board_->at(to_)) {
+    , to_{to}
+    , piece_{nullptr} {
+    if (parent_->at(to_)) {
         std::stringstream ss;
         ss << "Cannot move piece to " << to_ << ": this space is occupied";
         throw invalid_piece(ss.str());
     }
-    if (!board_->at(from_)) {
+    auto piece = parent_->at(from_);
+    if (!piece) {
         std::stringstream ss;
         ss << "Cannot move piece from " << from_ << ": this space is empty";
         throw invalid_piece(ss.str());
     }
+    piece_ = *piece;
+    hash_ ^= zobrist(from_, *piece_) ^ zobrist(to_, *piece_);
 }
 
 std::optional<const Piece *>
 Board::MovedPiece::at(Coord coord) const {
+    ChainDepthProbe probe;
     if (coord == to_) {
-        return board_->at(from_);
+        return parent_->at(from_);
     } else if (coord == from_) {
         return std::nullopt;
     } else {
-        return board_->at(coord);
+        return parent_->at(coord);
     }
 }
 
+std::size_t
+Board::MovedPiece::edits(std::array<Edit, 2> &out) const {
+    out[0] = {squareIndex(from_), piece_, nullptr};
+    out[1] = {squareIndex(to_), nullptr, piece_};
+    return 2;
+}
+
+Board::Branch::Branch(std::shared_ptr<const Board> board)
+    : Board{std::move(board), sizeof(Branch)} {}
+
+std::optional<const Piece *>
+Board::Branch::at(Coord coord) const {
+    ChainDepthProbe probe;
+    return parent_->at(coord);
+}
+
+std::size_t
+Board::Branch::edits(std::array<Edit, 2> &) const {
+    return 0;
+}
+
 invalid_piece::invalid_piece(const std::string &arg)
-    : std::runtime_error(arg) {}
+    : std::runtime_error(arg) {
+    Stats::add(Stats::Counter::InvalidPiece);
+}
 
 } // namespace Chess
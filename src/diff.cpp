@@ -0,0 +1,81 @@
+//
+// Created by taylor-santos on 10/18/2026 at 21:06.
+//
+
+#include "diff.h"
+
+#include <array>
+
+#include "attacks.h"
+#include "piece.h"
+
+namespace Chess {
+
+std::vector<SquareChange>
+diff(const Board &from, const Board &to) {
+    // The contents of each square one side changed, as of the common ancestor and as of the Board
+    // itself, recorded by the nodes themselves so that nothing older than the ancestor is visited.
+    struct Side {
+        std::uint64_t                 touched = 0;
+        std::array<const Piece *, 64> before{};
+        std::array<const Piece *, 64> after{};
+    } sides[2];
+
+    bool related = Board::walkToCommonAncestor(from, to, [&](const Board &node, bool toSide) {
+        auto                      &side = sides[toSide];
+        std::array<Board::Edit, 2> edits;
+        auto                       count = node.edits(edits);
+        for (std::size_t i = 0; i < count; i++) {
+            auto [square, before, after] = edits[i];
+            auto bit                     = std::uint64_t{1} << square;
+            // Nodes are visited newest first, so the first edit of a square holds its final
+            // contents, and the last holds its contents in the ancestor.
+            if (!(side.touched & bit)) side.after[square] = after;
+            side.before[square] = before;
+            side.touched |= bit;
+        }
+    });
+
+    std::vector<SquareChange> changes;
+    auto                      report = [&](int square, const Piece *before, const Piece *after) {
+        if ((before == nullptr) != (after == nullptr) || (before && *before != *after)) {
+            auto wrap = [](const Piece *piece) {
+                return piece ? std::optional(piece) : std::nullopt;
+            };
+            changes.push_back({coordOf(square), wrap(before), wrap(after)});
+        }
+    };
+
+    if (!related) {
+        // Boards with different roots share no history, so every square is compared.
+        for (int square = 0; square < 64; square++) {
+            auto before = from.at(coordOf(square));
+            auto after  = to.at(coordOf(square));
+            report(square, before.value_or(nullptr), after.value_or(nullptr));
+        }
+        return changes;
+    }
+
+    auto &[fromSide, toSide] = sides;
+    forEachSquare(fromSide.touched | toSide.touched, [&](int square) {
+        auto bit = std::uint64_t{1} << square;
+        // A square only one side changed still holds the ancestor's contents on the other side.
+        auto common = fromSide.touched & bit ? fromSide.before[square] : toSide.before[square];
+        report(
+            square,
+            fromSide.touched & bit ? fromSide.after[square] : common,
+            toSide.touched & bit ? toSide.after[square] : common);
+    });
+    return changes;
+}
+
+std::optional<std::size_t>
+historyDistance(const Board &from, const Board &to) {
+    std::size_t distance = 0;
+    if (!Board::walkToCommonAncestor(from, to, [&](const Board &, bool) { distance++; })) {
+        return std::nullopt;
+    }
+    return distance;
+}
+
+} // namespace Chess
@@ -0,0 +1,73 @@
+//
+// Created by taylor-santos on 10/18/2026 at 18:41.
+//
+
+#include "history.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace Chess {
+
+static_assert(
+    (PositionHistory::capacity & (PositionHistory::capacity - 1)) == 0,
+    "PositionHistory::capacity must be a power of two");
+
+PositionHistory::PositionHistory(std::uint64_t hash, std::size_t halfmoveClock)
+    : entries_{}
+    , size_{1}
+    , retained_{1} {
+    entries_[0] = {hash, halfmoveClock};
+}
+
+void
+PositionHistory::push(std::uint64_t hash, bool irreversible) {
+    std::size_t clock = irreversible ? 0 : halfmoveClock() + 1;
+
+    entries_[size_ & (capacity - 1)] = {hash, clock};
+    size_++;
+    retained_ = std::min(retained_ + 1, capacity);
+}
+
+void
+PositionHistory::pop() {
+    if (retained_ <= 1) {
+        throw std::out_of_range("PositionHistory::pop() has no earlier position to return to");
+    }
+    size_--;
+    retained_--;
+}
+
+std::size_t
+PositionHistory::repetitions() const {
+    auto &current = entries_[(size_ - 1) & (capacity - 1)];
+    auto  window  = std::min(current.halfmoveClock, retained_ - 1);
+
+    std::size_t count = 0;
+    for (std::size_t back = 2; back <= window; back += 2) {
+        if (entries_[(size_ - 1 - back) & (capacity - 1)].hash == current.hash) count++;
+    }
+    return count;
+}
+
+bool
+PositionHistory::isThreefoldRepetition() const {
+    return repetitions() >= 2;
+}
+
+bool
+PositionHistory::isFiftyMoveDraw() const {
+    return halfmoveClock() >= fiftyMovePlies;
+}
+
+std::size_t
+PositionHistory::halfmoveClock() const {
+    return entries_[(size_ - 1) & (capacity - 1)].halfmoveClock;
+}
+
+std::size_t
+PositionHistory::size() const {
+    return size_;
+}
+
+} // namespace Chess
@@ -0,0 +1,87 @@
+//
+// Created by taylor-santos on 10/18/2026 at 12:04.
+//
+
+#include "interner.h"
+
+#include <stdexcept>
+
+#include "board.h"
+
+namespace Chess {
+
+BoardInterner::BoardInterner(std::size_t shards)
+    : shards_(shards) {
+    if (shards == 0) {
+        throw std::invalid_argument("BoardInterner requires at least one shard");
+    }
+}
+
+BoardInterner::Shard &
+BoardInterner::shardFor(std::uint64_t hash) {
+    // The low bits select a bucket inside the shard's map, so use the high bits to pick a shard.
+    return shards_[(hash >> 32U) % shards_.size()];
+}
+
+std::shared_ptr<const Board>
+BoardInterner::intern(const Board &board) {
+    auto  hash  = board.hash();
+    auto &shard = shardFor(hash);
+    {
+        std::lock_guard lock{shard.mutex};
+        auto [begin, end] = shard.boards.equal_range(hash);
+        for (auto it = begin; it != end; ++it) {
+            if (*it->second == board) return it->second;
+        }
+    }
+
+    // Flatten outside of the lock, then check again in case another thread won the race.
+    auto canonical = board.flatten();
+
+    std::lock_guard lock{shard.mutex};
+    auto [begin, end] = shard.boards.equal_range(hash);
+    for (auto it = begin; it != end; ++it) {
+        if (*it->second == *canonical) return it->second;
+    }
+    shard.boards.emplace(hash, canonical);
+    return canonical;
+}
+
+std::size_t
+BoardInterner::prune() {
+    std::size_t removed = 0;
+    for (auto &shard : shards_) {
+        std::lock_guard lock{shard.mutex};
+        for (auto it = shard.boards.begin(); it != shard.boards.end();) {
+            // Canonical Boards are only handed out by intern(), which holds this lock, so a use
+            // count of one cannot increase while we look at it.
+            if (it->second.use_count() == 1) {
+                it = shard.boards.erase(it);
+                removed++;
+            } else {
+                ++it;
+            }
+        }
+    }
+    return removed;
+}
+
+void
+BoardInterner::clear() {
+    for (auto &shard : shards_) {
+        std::lock_guard lock{shard.mutex};
+        shard.boards.clear();
+    }
+}
+
+std::size_t
+BoardInterner::size() const {
+    std::size_t total = 0;
+    for (auto &shard : shards_) {
+        std::lock_guard lock{shard.mutex};
+        total += shard.boards.size();
+    }
+    return total;
+}
+
+} // namespace Chess
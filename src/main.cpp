@@ -8,6 +8,11 @@
 #include "imgui_impl_glfw.h"
 #include "imgui_impl_opengl3.h"
 #include <cstdio>
+#include <filesystem>
+#include <fstream>
+
+#include "audio.h"
+#include "stats.h"
 
 #include <glad/glad.h>
 
@@ -28,6 +33,66 @@ glfw_error_callback(int error, const char *description) {
     fprintf(stderr, "Glfw Error %d: %s\n", error, description);
 }
 
+// Show a window listing the current instrumentation counters (see include/stats.h), with buttons
+// to zero them or dump them to stats.json in the working directory.
+static void
+showStatsWindow(bool *open) {
+    using namespace Chess;
+
+    ImGui::Begin("Statistics", open);
+    if (!Stats::enabled) {
+        ImGui::TextDisabled("Reconfigure with -DPORTAL_CHESS_STATS=ON to collect statistics.");
+        ImGui::End();
+        return;
+    }
+
+    auto snap = Stats::snapshot();
+    for (std::size_t i = 0; i < Stats::counterCount; i++) {
+        ImGui::Text(
+            "%-16s %llu",
+            Stats::name(static_cast<Stats::Counter>(i)),
+            static_cast<unsigned long long>(snap.counters[i]));
+    }
+    ImGui::Separator();
+    ImGui::Text("at() average depth %.2f", snap.averageAtDepth());
+    ImGui::Text(
+        "at() max depth     %llu",
+        static_cast<unsigned long long>(snap[Stats::Gauge::AtMaxDepth]));
+    ImGui::Text("search nodes/sec   %.0f", snap.searchNodesPerSecond());
+    ImGui::Separator();
+    if (ImGui::Button("Reset")) Stats::reset();
+    ImGui::SameLine();
+    if (ImGui::Button("Dump JSON")) {
+        std::ofstream file{"stats.json"};
+        snap.toJson(file);
+    }
+    ImGui::End();
+}
+
+// Load the standard sound effects, reporting any that cannot be decoded, e.g. an OGG file when
+// stb_vorbis was not found at configure time. The sounds before the failing one are kept.
+static void
+loadSounds(Chess::Audio::SoundBank &bank) {
+    try {
+        bank.loadDirectory(std::filesystem::path{PORTAL_CHESS_SFX_DIR} / "standard");
+    } catch (const std::exception &e) {
+        fprintf(stderr, "Failed to load sound effects: %s\n", e.what());
+    }
+}
+
+// Show a window reporting the loaded sound effects, with a button to play the move sound.
+static void
+showSoundWindow(bool *open, const Chess::Audio::SoundBank &bank, Chess::Audio::Mixer &mixer) {
+    ImGui::Begin("Sound", open);
+    ImGui::Text("%zu sound effects loaded", bank.size());
+    if (auto move = bank.find("std_move")) {
+        if (ImGui::Button("Play move sound")) mixer.play(*move);
+    } else {
+        ImGui::TextDisabled("std_move could not be loaded, see the console for details.");
+    }
+    ImGui::End();
+}
+
 int
 main(int, char **) {
     // Setup window
@@ -107,9 +172,19 @@ main(int, char **) {
     // ImFont* font = io.Fonts->AddFontFromFileTTF("c:\\Windows\\Fonts\\ArialUni.ttf", 18.0f, NULL,
     // io.Fonts->GetGlyphRangesJapanese()); IM_ASSERT(font != NULL);
 
+    // Load the sound effects and start mixing them. There is no sound device backend yet, so the
+    // mix goes to a NullOutput, which only keeps time the way a device would.
+    constexpr unsigned      sampleRate = 48000;
+    Chess::Audio::SoundBank sounds{sampleRate};
+    loadSounds(sounds);
+    Chess::Audio::Mixer       mixer{sounds};
+    Chess::Audio::AudioThread audio{mixer, std::make_unique<Chess::Audio::NullOutput>(sampleRate)};
+
     // Our state
     bool   show_demo_window    = true;
     bool   show_another_window = false;
+    bool   show_stats_window   = true;
+    bool   show_sound_window   = true;
     ImVec4 clear_color         = ImVec4(0.45f, 0.55f, 0.60f, 1.00f);
 
     // Main loop
@@ -148,6 +223,8 @@ main(int, char **) {
                 "Demo Window",
                 &show_demo_window); // Edit bools storing our window open/close state
             ImGui::Checkbox("Another Window", &show_another_window);
+            ImGui::Checkbox("Statistics", &show_stats_window);
+            ImGui::Checkbox("Sound", &show_sound_window);
 
             ImGui::SliderFloat(
                 "float",
@@ -182,6 +259,12 @@ main(int, char **) {
             ImGui::End();
         }
 
+        // 4. Show the instrumentation counters.
+        if (show_stats_window) showStatsWindow(&show_stats_window);
+
+        // 5. Show the sound effects.
+        if (show_sound_window) showSoundWindow(&show_sound_window, sounds, mixer);
+
         // Rendering
         ImGui::Render();
         int display_w, display_h;
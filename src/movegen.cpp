@@ -0,0 +1,117 @@
+//
+// Created by taylor-santos on 10/18/2026 at 16:48.
+//
+
+#include "movegen.h"
+
+#include "board.h"
+
+namespace Chess {
+
+namespace {
+
+char
+typeLetter(Type type) {
+    switch (type) {
+        case Type::Bishop: return 'B';
+        case Type::King: return 'K';
+        case Type::Knight: return 'N';
+        case Type::Pawn: return 'P';
+        case Type::Portal: return 'O';
+        case Type::Queen: return 'Q';
+        case Type::Rook: return 'R';
+    }
+    return '?';
+}
+
+BasicMove
+toSquares(const Move &move) {
+    return {squareOf(move.from), squareOf(move.to), move.promotion};
+}
+
+std::vector<Move>
+toCoords(const std::vector<BasicMove> &moves) {
+    std::vector<Move> result;
+    result.reserve(moves.size());
+    for (auto &move : moves) {
+        result.push_back({coordOf(move.from), coordOf(move.to), move.promotion});
+    }
+    return result;
+}
+
+} // namespace
+
+bool
+Move::operator==(const Move &other) const {
+    return from == other.from && to == other.to && promotion == other.promotion;
+}
+
+bool
+Move::operator!=(const Move &other) const {
+    return !(*this == other);
+}
+
+std::ostream &
+operator<<(std::ostream &os, const Move &move) {
+    os << move.from << move.to;
+    if (move.promotion) os << '=' << typeLetter(*move.promotion);
+    return os;
+}
+
+bool
+BasicMove::operator==(const BasicMove &other) const {
+    return from == other.from && to == other.to && promotion == other.promotion;
+}
+
+bool
+BasicMove::operator!=(const BasicMove &other) const {
+    return !(*this == other);
+}
+
+LegalityMasks::LegalityMasks(const AttackMap &map, Color color)
+    : BasicLegalityMasks{map, color} {}
+
+bool
+LegalityMasks::isLegal(const Move &move) const {
+    return isLegal(toSquares(move));
+}
+
+template class BasicLegalityMasks<StandardGeometry>;
+
+template std::vector<BasicMove>
+pseudoLegalMoves(const BasicAttackMap<StandardGeometry> &, Color);
+template std::vector<BasicMove>
+legalMoves(const BasicAttackMap<StandardGeometry> &, Color);
+template bool
+inCheck(const BasicAttackMap<StandardGeometry> &, Color);
+template void
+applyMove(BasicAttackMap<StandardGeometry> &, const BasicMove &);
+
+std::vector<Move>
+pseudoLegalMoves(const AttackMap &map, Color color) {
+    return toCoords(pseudoLegalMoves<StandardGeometry>(map, color));
+}
+
+std::vector<Move>
+legalMoves(const AttackMap &map, Color color) {
+    return toCoords(legalMoves<StandardGeometry>(map, color));
+}
+
+std::shared_ptr<const Board>
+applyMove(const Board &board, const Move &move) {
+    auto next = board.at(move.to) ? board.removePiece(move.to)->movePiece(move.from, move.to)
+                                  : board.movePiece(move.from, move.to);
+    if (move.promotion) {
+        auto color = (*next->at(move.to))->color;
+        next       = next->removePiece(move.to);
+        next       = next->addPiece(move.to, std::make_unique<Piece>(*move.promotion, color));
+    }
+    return next;
+}
+
+void
+applyMove(AttackMap &map, const Move &move) {
+    applyMove<StandardGeometry>(map, toSquares(move));
+}
+
+} // namespace Chess
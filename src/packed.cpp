@@ -0,0 +1,175 @@
+//
+// Created by taylor-santos on 10/18/2026 at 21:52.
+//
+
+#include "packed.h"
+
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    define PORTAL_CHESS_PACKED_SSE2
+#    include <emmintrin.h>
+#endif
+
+#include "attacks.h"
+
+namespace Chess {
+
+// One byte per square, in Bitboard order, holding the same codes as the packed nibbles.
+using SquareCodes = std::array<std::uint8_t, 64>;
+
+static std::uint8_t
+encode(const Piece &piece) {
+    return static_cast<std::uint8_t>(
+        1 + static_cast<int>(piece.type) * 2 + static_cast<int>(piece.color));
+}
+
+static Piece
+decode(std::uint8_t code) {
+    return {static_cast<Type>((code - 1) / 2), static_cast<Color>((code - 1) % 2)};
+}
+
+// Pack 64 one-byte codes into 32 bytes of nibbles, two squares per byte.
+static void
+packCodes(const SquareCodes &codes, std::uint8_t *out) {
+#if defined(PORTAL_CHESS_PACKED_SSE2)
+    // Each 16-bit lane holds an even square in its low byte and the following odd square in its
+    // high byte. Shifting the odd square down into bits 4-7 and saturating to 8 bits packs them.
+    auto lowByte    = _mm_set1_epi16(0x00FF);
+    auto highNibble = _mm_set1_epi16(0x00F0);
+    auto combine    = [&](const std::uint8_t *in) {
+        auto lanes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in));
+        return _mm_or_si128(
+            _mm_and_si128(lanes, lowByte),
+            _mm_and_si128(_mm_srli_epi16(lanes, 4), highNibble));
+    };
+    for (int half = 0; half < 2; half++) {
+        auto low    = combine(codes.data() + half * 32);
+        auto high   = combine(codes.data() + half * 32 + 16);
+        auto packed = _mm_packus_epi16(low, high);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + half * 16), packed);
+    }
+#else
+    for (int i = 0; i < 32; i++) {
+        out[i] = static_cast<std::uint8_t>(codes[i * 2] | (codes[i * 2 + 1] << 4U));
+    }
+#endif
+}
+
+// Unpack 32 bytes of nibbles into 64 one-byte codes.
+static SquareCodes
+unpackCodes(const std::uint8_t *in) {
+    SquareCodes codes;
+#if defined(PORTAL_CHESS_PACKED_SSE2)
+    auto nibble = _mm_set1_epi8(0x0F);
+    for (int half = 0; half < 2; half++) {
+        auto bytes = _mm_load_si128(reinterpret_cast<const __m128i *>(in + half * 16));
+        auto even  = _mm_and_si128(bytes, nibble);
+        auto odd   = _mm_and_si128(_mm_srli_epi16(bytes, 4), nibble);
+        auto out   = reinterpret_cast<__m128i *>(codes.data() + half * 32);
+        _mm_storeu_si128(out, _mm_unpacklo_epi8(even, odd));
+        _mm_storeu_si128(out + 1, _mm_unpackhi_epi8(even, odd));
+    }
+#else
+    for (int i = 0; i < 32; i++) {
+        codes[i * 2]     = in[i] & 0x0FU;
+        codes[i * 2 + 1] = in[i] >> 4U;
+    }
+#endif
+    return codes;
+}
+
+// A bit set for every byte that is equal in both PackedBoards.
+static std::uint32_t
+equalBytes(const std::uint8_t *a, const std::uint8_t *b) {
+#if defined(PORTAL_CHESS_PACKED_SSE2)
+    std::uint32_t mask = 0;
+    for (int half = 0; half < 2; half++) {
+        auto x     = _mm_load_si128(reinterpret_cast<const __m128i *>(a + half * 16));
+        auto y     = _mm_load_si128(reinterpret_cast<const __m128i *>(b + half * 16));
+        auto equal = static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(x, y)));
+        mask |= equal << (half * 16);
+    }
+    return mask;
+#else
+    std::uint32_t mask = 0;
+    for (int i = 0; i < 32; i++) {
+        if (a[i] == b[i]) mask |= std::uint32_t{1} << i;
+    }
+    return mask;
+#endif
+}
+
+PackedBoard::PackedBoard()
+    : data_{} {}
+
+PackedBoard::PackedBoard(const Board &board)
+    : data_{} {
+    SquareCodes codes{};
+    for (int square = 0; square < 64; square++) {
+        if (auto piece = board.at(coordOf(square))) codes[square] = encode(**piece);
+    }
+    packCodes(codes, data_.data());
+}
+
+std::shared_ptr<const Board>
+PackedBoard::unpack(std::size_t historyBudget) const {
+    auto codes = unpackCodes(data_.data());
+
+    std::vector<std::pair<Coord, incomplete_ptr<Piece>>> pieces;
+    for (int square = 0; square < 64; square++) {
+        if (codes[square]) {
+            pieces.emplace_back(coordOf(square), std::make_unique<Piece>(decode(codes[square])));
+        }
+    }
+    return Board::make(std::move(pieces), historyBudget);
+}
+
+std::optional<Piece>
+PackedBoard::at(Coord coord) const {
+    auto square = squareOf(coord);
+    auto code   = static_cast<std::uint8_t>((data_[square / 2] >> (square % 2 * 4)) & 0x0FU);
+    return code ? std::optional(decode(code)) : std::nullopt;
+}
+
+const std::array<std::uint8_t, PackedBoard::bytes> &
+PackedBoard::data() const {
+    return data_;
+}
+
+std::uint64_t
+PackedBoard::hash() const {
+    std::uint64_t words[bytes / 8];
+    std::memcpy(words, data_.data(), bytes);
+
+    // The first multiply of each word does not depend on the others, but folding into `result`
+    // is a serial chain of four dependent multiplies.
+    std::uint64_t result = 0x9e3779b97f4a7c15ULL;
+    for (auto word : words) {
+        word *= 0xbf58476d1ce4e5b9ULL;
+        result = (result ^ word ^ (word >> 31U)) * 0x94d049bb133111ebULL;
+    }
+    return result ^ (result >> 29U);
+}
+
+bool
+PackedBoard::operator==(const PackedBoard &other) const {
+    return equalBytes(data_.data(), other.data_.data()) == 0xFFFFFFFFU;
+}
+
+bool
+PackedBoard::operator!=(const PackedBoard &other) const {
+    return !(*this == other);
+}
+
+bool
+PackedBoard::operator<(const PackedBoard &other) const {
+    auto differ = ~equalBytes(data_.data(), other.data_.data());
+    if (!differ) return false;
+    auto first = lowestSquare(differ);
+    return data_[first] < other.data_[first];
+}
+
+} // namespace Chess
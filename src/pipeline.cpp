@@ -0,0 +1,187 @@
+//
+// Created by taylor-santos on 10/19/2026 at 00:47.
+//
+
+#include "pipeline.h"
+
+#include <sstream>
+
+#include "board.h"
+#include "position.h"
+
+namespace Chess {
+
+// The pool and queue index of the worker running on this thread, if any, so that tasks submitted
+// from a worker go to that worker's own queue.
+static thread_local const ThreadPool *currentPool  = nullptr;
+static thread_local std::size_t       currentQueue = 0;
+
+ThreadPool::ThreadPool(unsigned threads)
+    : queues_(threads)
+    , pending_{0}
+    , nextQueue_{0}
+    , stopping_{false} {
+    if (threads == 0) throw std::invalid_argument("ThreadPool needs at least one thread");
+    workers_.reserve(threads);
+    for (std::size_t index = 0; index < threads; index++) {
+        workers_.emplace_back([this, index] { work(index); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard lock{mutex_};
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    for (auto &worker : workers_) {
+        worker.join();
+    }
+}
+
+void
+ThreadPool::submit(std::function<void()> task) {
+    bool        local = currentPool == this;
+    std::size_t index;
+    {
+        // Count the task before it is published, so that a worker taking it can never decrement
+        // pending_ below zero.
+        std::lock_guard lock{mutex_};
+        index = local ? currentQueue : nextQueue_++ % queues_.size();
+        pending_++;
+    }
+    {
+        std::lock_guard lock{queues_[index].mutex};
+        if (local) {
+            queues_[index].tasks.push_front(std::move(task));
+        } else {
+            queues_[index].tasks.push_back(std::move(task));
+        }
+    }
+    wake_.notify_one();
+}
+
+unsigned
+ThreadPool::size() const {
+    return static_cast<unsigned>(workers_.size());
+}
+
+void
+ThreadPool::work(std::size_t index) {
+    currentPool  = this;
+    currentQueue = index;
+    for (;;) {
+        if (auto task = take(index)) {
+            (*task)();
+            continue;
+        }
+        std::unique_lock lock{mutex_};
+        wake_.wait(lock, [&] { return pending_ > 0 || stopping_; });
+        if (stopping_ && pending_ == 0) return;
+    }
+}
+
+std::optional<std::function<void()>>
+ThreadPool::take(std::size_t index) {
+    for (std::size_t i = 0; i < queues_.size(); i++) {
+        auto            &queue = queues_[(index + i) % queues_.size()];
+        std::unique_lock lock{queue.mutex};
+        if (queue.tasks.empty()) continue;
+
+        auto task = std::move(queue.tasks.front());
+        queue.tasks.pop_front();
+        lock.unlock();
+
+        std::lock_guard pendingLock{mutex_};
+        pending_--;
+        return task;
+    }
+    return std::nullopt;
+}
+
+static void
+writeScore(std::ostream &os, int score) {
+    if (score > Search::mateThreshold) {
+        os << "mate " << Search::mateScore - score;
+    } else if (score < -Search::mateThreshold) {
+        os << "mate " << -(Search::mateScore + score);
+    } else {
+        os << "cp " << score;
+    }
+}
+
+std::string
+analyzeLine(const std::string &line, Search &search, const SearchLimits &limits) {
+    std::stringstream ss;
+    try {
+        auto      position = parseGame(line);
+        auto      board    = position.board.unpack();
+        AttackMap map{*board};
+        search.clear();
+        auto result = search.run(map, position.toMove, limits);
+
+        ss << "bestmove ";
+        if (result.bestMove) {
+            ss << *result.bestMove;
+        } else {
+            ss << "none";
+        }
+        ss << " score ";
+        writeScore(ss, result.score);
+        ss << " depth " << result.depth << " nodes " << result.nodes;
+    } catch (const std::exception &e) {
+        return std::string{"error "} + e.what();
+    }
+    return ss.str();
+}
+
+std::size_t
+analyze(std::istream &in, std::ostream &out, const AnalysisOptions &options) {
+    // Everything that can reject the options or fail to allocate is built before the writer
+    // thread starts. One Search per worker, indexed by the worker's queue.
+    ReorderBuffer<std::string>           buffer{options.window};
+    std::vector<std::unique_ptr<Search>> searches;
+    for (unsigned i = 0; i < options.threads; i++) {
+        searches.push_back(std::make_unique<Search>(options.tableEntries));
+    }
+    std::optional<ThreadPool> pool{std::in_place, options.threads};
+
+    std::thread writer{[&] {
+        while (auto result = buffer.next()) {
+            out << *result << '\n';
+        }
+        out.flush();
+    }};
+    // Runs every submitted task, then lets the writer drain the buffer. Also used when reading
+    // throws, so that the writer is never left joinable.
+    auto finish = [&] {
+        pool.reset();
+        buffer.close();
+        writer.join();
+    };
+
+    std::size_t count = 0;
+    try {
+        std::string line;
+        while (std::getline(in, line)) {
+            if (!line.empty() && line.back() == '\r') line.pop_back();
+            if (line.empty() || line[0] == '#') continue;
+
+            // Blocks while the window is full, so reading never gets more than window games
+            // ahead of writing.
+            auto sequence = buffer.reserve();
+            pool->submit([&buffer, &options, &searches, sequence, line] {
+                auto &search = *searches[currentQueue];
+                buffer.complete(sequence, line + '\t' + analyzeLine(line, search, options.limits));
+            });
+            count++;
+        }
+    } catch (...) {
+        finish();
+        throw;
+    }
+    finish();
+    return count;
+}
+
+} // namespace Chess
@@ -0,0 +1,162 @@
+//
+// Created by taylor-santos on 10/18/2026 at 22:58.
+//
+
+#include "position.h"
+
+#include <algorithm>
+#include <cctype>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include "attacks.h"
+#include "board.h"
+#include "coord.h"
+
+namespace Chess {
+
+static constexpr char pieceLetters[] = "BKNPOQR";
+
+static std::optional<Type>
+typeOf(char letter) {
+    auto upper = static_cast<char>(std::toupper(static_cast<unsigned char>(letter)));
+    for (int type = 0; pieceLetters[type]; type++) {
+        if (pieceLetters[type] == upper) return static_cast<Type>(type);
+    }
+    return std::nullopt;
+}
+
+static char
+letterOf(const Piece &piece) {
+    auto letter = pieceLetters[static_cast<int>(piece.type)];
+    return piece.color == Color::White
+               ? letter
+               : static_cast<char>(std::tolower(static_cast<unsigned char>(letter)));
+}
+
+static std::vector<std::string_view>
+splitWords(std::string_view text) {
+    std::vector<std::string_view> words;
+    while (!text.empty()) {
+        auto start = text.find_first_not_of(" \t\r");
+        if (start == std::string_view::npos) break;
+        text     = text.substr(start);
+        auto end = std::min(text.find_first_of(" \t\r"), text.size());
+        words.push_back(text.substr(0, end));
+        text = text.substr(end);
+    }
+    return words;
+}
+
+static std::invalid_argument
+invalid(std::string_view what, std::string_view text) {
+    std::stringstream ss;
+    ss << "Invalid " << what << " \"" << text << "\"";
+    return std::invalid_argument(ss.str());
+}
+
+static Position
+parseWords(const std::vector<std::string_view> &words, std::string_view text) {
+    if (words.size() < 2 || words[1].size() != 1 || (words[1] != "w" && words[1] != "b")) {
+        throw invalid("position", text);
+    }
+
+    std::vector<std::pair<Coord, incomplete_ptr<Piece>>> pieces;
+    int                                                  file = A;
+    int                                                  rank = _8;
+    for (auto c : words[0]) {
+        if (c == '/') {
+            if (file != H + 1 || rank == _1) throw invalid("position", text);
+            file = A;
+            rank--;
+        } else if ('1' <= c && c <= '8') {
+            file += c - '0';
+            if (file > H + 1) throw invalid("position", text);
+        } else if (auto type = typeOf(c); type && file <= H) {
+            auto color = std::isupper(static_cast<unsigned char>(c)) ? Color::White : Color::Black;
+            pieces.emplace_back(
+                Coord{static_cast<File>(file), static_cast<Rank>(rank)},
+                std::make_unique<Piece>(*type, color));
+            file++;
+        } else {
+            throw invalid("position", text);
+        }
+    }
+    if (file != H + 1 || rank != _1) throw invalid("position", text);
+
+    auto toMove = words[1] == "w" ? Color::White : Color::Black;
+    return {PackedBoard{*Board::make(std::move(pieces))}, toMove};
+}
+
+Position
+parsePosition(std::string_view text) {
+    auto words = splitWords(text);
+    if (words.size() != 2) throw invalid("position", text);
+    return parseWords(words, text);
+}
+
+std::string
+formatPosition(const Position &position) {
+    std::stringstream ss;
+    for (int rank = _8; rank >= _1; rank--) {
+        int empty = 0;
+        for (int file = A; file <= H; file++) {
+            auto piece = position.board.at({static_cast<File>(file), static_cast<Rank>(rank)});
+            if (!piece) {
+                empty++;
+                continue;
+            }
+            if (empty) ss << empty;
+            empty = 0;
+            ss << letterOf(*piece);
+        }
+        if (empty) ss << empty;
+        if (rank != _1) ss << '/';
+    }
+    ss << ' ' << (position.toMove == Color::White ? 'w' : 'b');
+    return ss.str();
+}
+
+Move
+parseMove(std::string_view text) {
+    auto coordAt = [&](std::size_t i) {
+        auto file = std::toupper(static_cast<unsigned char>(text[i])) - 'A' + 1;
+        auto rank = text[i + 1] - '0';
+        if (file < A || H < file || rank < _1 || _8 < rank) throw invalid("move", text);
+        return Coord{static_cast<File>(file), static_cast<Rank>(rank)};
+    };
+    if (text.size() != 4 && (text.size() != 6 || text[4] != '=')) throw invalid("move", text);
+
+    Move move{coordAt(0), coordAt(2), std::nullopt};
+    if (text.size() == 6) {
+        move.promotion = typeOf(text[5]);
+        if (!move.promotion) throw invalid("move", text);
+    }
+    return move;
+}
+
+Position
+parseGame(std::string_view text) {
+    auto words    = splitWords(text);
+    auto position = parseWords(words, text);
+    if (words.size() == 2) return position;
+    if (words[2] != "moves") throw invalid("game", text);
+
+    auto      board = position.board.unpack();
+    AttackMap map{*board};
+    for (std::size_t i = 3; i < words.size(); i++) {
+        auto move  = parseMove(words[i]);
+        auto legal = legalMoves(map, position.toMove);
+        if (std::find(legal.begin(), legal.end(), move) == legal.end()) {
+            throw invalid("move", words[i]);
+        }
+        board = applyMove(*board, move);
+        applyMove(map, move);
+        position.toMove = position.toMove == Color::White ? Color::Black : Color::White;
+    }
+    position.board = PackedBoard{*board};
+    return position;
+}
+
+} // namespace Chess
@@ -0,0 +1,344 @@
+//
+// Created by taylor-santos on 10/18/2026 at 23:41.
+//
+
+#include "search.h"
+
+#include <algorithm>
+#include <optional>
+#include <vector>
+
+#include "stats.h"
+
+namespace Chess {
+
+namespace {
+
+constexpr int pieceValues[] = {
+    330, // Bishop
+    0,   // King
+    320, // Knight
+    100, // Pawn
+    0,   // Portal
+    900, // Queen
+    500, // Rook
+};
+
+constexpr int mobilityWeight = 2;
+
+int
+valueOf(Type type) {
+    return pieceValues[static_cast<int>(type)];
+}
+
+Color
+opponent(Color color) {
+    return color == Color::White ? Color::Black : Color::White;
+}
+
+// The splitmix64 finalizer.
+std::uint64_t
+mix(std::uint64_t x) {
+    x = (x ^ (x >> 30U)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27U)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31U);
+}
+
+// A hash of everything that affects the moves available: each piece and its square, which square
+// each portal is linked to, and the side to move.
+std::uint64_t
+hashPosition(const AttackMap &map, Color toMove) {
+    std::uint64_t key = toMove == Color::Black ? mix(~std::uint64_t{0}) : 0;
+    for (auto side : {Color::White, Color::Black}) {
+        forEachSquare(map.pieces(side) | map.portals(side), [&](int square) {
+            auto &piece = *map.at(square);
+            auto  code  = static_cast<std::uint64_t>(
+                (static_cast<int>(piece.type) * 2 + static_cast<int>(piece.color)) * 64 + square);
+            // Portal codes are all larger than any other piece's code, so they never collide.
+            if (piece.type == Type::Portal) code = code * 65 + map.portalPartner(square) + 1;
+            key ^= mix(code + 1);
+        });
+    }
+    return key;
+}
+
+// Mate scores are stored relative to the node they were found at rather than the root, so that
+// they stay correct when the same position is reached at a different ply.
+int
+toTable(int score, int ply) {
+    if (score > Search::mateThreshold) return score + ply;
+    if (score < -Search::mateThreshold) return score - ply;
+    return score;
+}
+
+int
+fromTable(int score, int ply) {
+    if (score > Search::mateThreshold) return score - ply;
+    if (score < -Search::mateThreshold) return score + ply;
+    return score;
+}
+
+// Order the transposition table's move first, then captures of more valuable pieces, then
+// promotions, then quiet moves, keeping the generation order within each group so that the search
+// is deterministic.
+void
+orderMoves(
+    const AttackMap                &map,
+    std::vector<BasicMove>         &moves,
+    const std::optional<BasicMove> &first) {
+    auto priority = [&](const BasicMove &move) {
+        auto &victim = map.at(move.to);
+        auto  score  = victim ? 10 * valueOf(victim->type) - valueOf(map.at(move.from)->type) : 0;
+        return score + (move.promotion ? valueOf(*move.promotion) : 0);
+    };
+    std::stable_sort(moves.begin(), moves.end(), [&](const BasicMove &a, const BasicMove &b) {
+        return priority(a) > priority(b);
+    });
+    if (first) {
+        std::stable_partition(moves.begin(), moves.end(), [&](const BasicMove &move) {
+            return move == *first;
+        });
+    }
+}
+
+} // namespace
+
+int
+evaluate(const AttackMap &map, Color color) {
+    int score = 0;
+    for (auto side : {Color::White, Color::Black}) {
+        int total = 0;
+        forEachSquare(map.pieces(side), [&](int square) {
+            total += valueOf(map.at(square)->type);
+            total += mobilityWeight * countSquares(map.attacksFrom(square));
+        });
+        score += side == color ? total : -total;
+    }
+    return score;
+}
+
+Search::Search(std::size_t tableEntries)
+    : table_{tableEntries}
+    , stop_{false}
+    , ponderHit_{false}
+    , clockStart_{0}
+    , timer_{nullptr}
+    , ponder_{false}
+    , aborted_{false}
+    , nodes_{0}
+    , nodeLimit_{0} {}
+
+SearchResult
+Search::run(const AttackMap &map, Color toMove, const SearchLimits &limits) {
+    // Stopped before waiting for a ponder search to end, so that the wait does not count.
+    std::optional<Stats::ScopedTimer> scopedTimer{std::in_place, Stats::Timer::Search};
+
+    auto now = std::chrono::steady_clock::now();
+    clockStart_.store(now.time_since_epoch().count());
+    ponder_    = limits.ponder;
+    aborted_   = false;
+    nodes_     = 0;
+    nodeLimit_ = limits.nodes;
+    table_.newSearch();
+
+    std::optional<TimeManager> timer;
+    if (limits.clock) timer.emplace(*limits.clock);
+
+    SearchResult result;
+    auto         moves = legalMoves<StandardGeometry>(map, toMove);
+    if (moves.empty()) {
+        result.score = inCheck(map, toMove) ? -mateScore : 0;
+        scopedTimer.reset();
+        waitForPonderEnd();
+        return result;
+    }
+    auto key = hashPosition(map, toMove);
+    auto hit = table_.probe(key);
+    orderMoves(map, moves, hit ? hit->move : std::nullopt);
+    result.bestMove = Move{coordOf(moves[0].from), coordOf(moves[0].to), moves[0].promotion};
+    timer_          = timer ? &*timer : nullptr;
+
+    for (int depth = 1; depth <= std::min(limits.depth, maxDepth); depth++) {
+        int       alpha = -mateScore;
+        BasicMove best  = moves[0];
+        for (auto &move : moves) {
+            auto child = map;
+            applyMove(child, move);
+            auto score = -negamax(child, opponent(toMove), depth - 1, 1, -mateScore, -alpha);
+            if (aborted_) break;
+            if (score > alpha) {
+                alpha = score;
+                best  = move;
+            }
+        }
+        if (aborted_) break;
+
+        // Search the best move first in the next iteration.
+        std::stable_partition(moves.begin(), moves.end(), [&](const BasicMove &move) {
+            return move == best;
+        });
+        result.bestMove = Move{coordOf(best.from), coordOf(best.to), best.promotion};
+        result.score    = alpha;
+        result.depth    = depth;
+        table_.store(key, depth, toTable(alpha, 0), TranspositionTable::Bound::Exact, best);
+        if (alpha > mateThreshold || alpha < -mateThreshold) break;
+
+        if (timer) {
+            timer->iterationDone(best, alpha, moves.size());
+            if (!pondering() && timer->shouldStop(elapsed())) break;
+        }
+    }
+    timer_       = nullptr;
+    result.nodes = nodes_;
+
+    // The expected reply is the best move stored for the position after our best move.
+    auto best  = moves.front();
+    auto child = map;
+    applyMove(child, best);
+    if (auto reply = table_.probe(hashPosition(child, opponent(toMove))); reply && reply->move) {
+        auto replies = legalMoves<StandardGeometry>(child, opponent(toMove));
+        if (std::find(replies.begin(), replies.end(), *reply->move) != replies.end()) {
+            auto &move        = *reply->move;
+            result.ponderMove = Move{coordOf(move.from), coordOf(move.to), move.promotion};
+        }
+    }
+    scopedTimer.reset();
+    waitForPonderEnd();
+    return result;
+}
+
+void
+Search::arm() {
+    stop_.store(false);
+    ponderHit_.store(false);
+}
+
+void
+Search::stop() {
+    {
+        std::lock_guard lock{mutex_};
+        stop_.store(true, std::memory_order_relaxed);
+    }
+    ponderEnded_.notify_all();
+}
+
+void
+Search::ponderHit() {
+    clockStart_.store(std::chrono::steady_clock::now().time_since_epoch().count());
+    {
+        std::lock_guard lock{mutex_};
+        ponderHit_.store(true);
+    }
+    ponderEnded_.notify_all();
+}
+
+void
+Search::clear() {
+    table_.clear();
+}
+
+int
+Search::negamax(const AttackMap &map, Color color, int depth, int ply, int alpha, int beta) {
+    using Bound = TranspositionTable::Bound;
+
+    if (!visit()) return 0;
+    if (depth <= 0) return quiesce(map, color, ply, alpha, beta);
+
+    auto key = hashPosition(map, color);
+    auto hit = table_.probe(key);
+    if (hit && hit->depth >= depth) {
+        auto score = fromTable(hit->score, ply);
+        if (hit->bound == Bound::Exact) return score;
+        if (hit->bound == Bound::Lower && score >= beta) return score;
+        if (hit->bound == Bound::Upper && score <= alpha) return score;
+    }
+
+    auto moves = legalMoves<StandardGeometry>(map, color);
+    if (moves.empty()) return inCheck(map, color) ? ply - mateScore : 0;
+    orderMoves(map, moves, hit ? hit->move : std::nullopt);
+
+    std::optional<BasicMove> best;
+    for (auto &move : moves) {
+        auto child = map;
+        applyMove(child, move);
+        auto score = -negamax(child, opponent(color), depth - 1, ply + 1, -beta, -alpha);
+        if (aborted_) return 0;
+        if (score >= beta) {
+            table_.store(key, depth, toTable(score, ply), Bound::Lower, move);
+            return score;
+        }
+        if (score > alpha) {
+            alpha = score;
+            best  = move;
+        }
+    }
+    table_.store(key, depth, toTable(alpha, ply), best ? Bound::Exact : Bound::Upper, best);
+    return alpha;
+}
+
+int
+Search::quiesce(const AttackMap &map, Color color, int ply, int alpha, int beta) {
+    if (!visit()) return 0;
+
+    auto standPat = evaluate(map, color);
+    if (standPat >= beta || ply >= maxDepth) return standPat;
+    alpha = std::max(alpha, standPat);
+
+    auto moves = legalMoves<StandardGeometry>(map, color);
+    moves.erase(
+        std::remove_if(
+            moves.begin(),
+            moves.end(),
+            [&](const BasicMove &move) { return !map.at(move.to); }),
+        moves.end());
+    orderMoves(map, moves, std::nullopt);
+
+    for (auto &move : moves) {
+        auto child = map;
+        applyMove(child, move);
+        auto score = -quiesce(child, opponent(color), ply + 1, -beta, -alpha);
+        if (aborted_) return 0;
+        if (score >= beta) return score;
+        alpha = std::max(alpha, score);
+    }
+    return alpha;
+}
+
+bool
+Search::visit() {
+    if ((nodeLimit_ && nodes_ >= nodeLimit_) || stop_.load(std::memory_order_relaxed)) {
+        aborted_ = true;
+        return false;
+    }
+    // Reading the clock is slow enough to only be worth doing every 1024 nodes.
+    if (timer_ && (nodes_ & 1023U) == 0 && !pondering() && timer_->outOfTime(elapsed())) {
+        aborted_ = true;
+        return false;
+    }
+    nodes_++;
+    Stats::add(Stats::Counter::SearchNodes);
+    return true;
+}
+
+bool
+Search::pondering() const {
+    return ponder_ && !ponderHit_.load(std::memory_order_relaxed);
+}
+
+// A pondering search is searching on the opponent's time, so it must not return before the
+// opponent has moved, even if it has nothing left to search.
+void
+Search::waitForPonderEnd() {
+    if (!ponder_) return;
+    std::unique_lock lock{mutex_};
+    ponderEnded_.wait(lock, [&] { return stop_.load() || ponderHit_.load(); });
+}
+
+TimeManager::Duration
+Search::elapsed() const {
+    std::chrono::steady_clock::time_point start{
+        std::chrono::steady_clock::duration{clockStart_.load()}};
+    return std::chrono::steady_clock::now() - start;
+}
+
+} // namespace Chess
@@ -0,0 +1,204 @@
+//
+// Created by taylor-santos on 10/18/2026 at 09:40.
+//
+
+#include "stats.h"
+
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+namespace Chess::Stats {
+
+namespace {
+
+class Registry {
+public:
+    void
+    attach(detail::Slot *slot) {
+        std::lock_guard lock{mutex_};
+        live_.push_back(slot);
+    }
+
+    void
+    detach(detail::Slot *slot) {
+        std::lock_guard lock{mutex_};
+        accumulate(retired_, *slot);
+        live_.erase(std::remove(live_.begin(), live_.end(), slot), live_.end());
+    }
+
+    [[nodiscard]] Snapshot
+    total() {
+        std::lock_guard lock{mutex_};
+        Snapshot        snap = retired_;
+        for (auto *slot : live_) {
+            accumulate(snap, *slot);
+        }
+        return snap;
+    }
+
+    void
+    clear() {
+        std::lock_guard lock{mutex_};
+        retired_ = {};
+        for (auto *slot : live_) {
+            for (auto &value : slot->counters) value.store(0, std::memory_order_relaxed);
+            for (auto &value : slot->gauges) value.store(0, std::memory_order_relaxed);
+            for (auto &value : slot->timerCalls) value.store(0, std::memory_order_relaxed);
+            for (auto &value : slot->timerNanos) value.store(0, std::memory_order_relaxed);
+        }
+    }
+
+private:
+    static void
+    accumulate(Snapshot &snap, const detail::Slot &slot) {
+        for (std::size_t i = 0; i < counterCount; i++) {
+            snap.counters[i] += slot.counters[i].load(std::memory_order_relaxed);
+        }
+        for (std::size_t i = 0; i < gaugeCount; i++) {
+            snap.gauges[i] =
+                std::max(snap.gauges[i], slot.gauges[i].load(std::memory_order_relaxed));
+        }
+        for (std::size_t i = 0; i < timerCount; i++) {
+            snap.timers[i].calls += slot.timerCalls[i].load(std::memory_order_relaxed);
+            snap.timers[i].nanos += slot.timerNanos[i].load(std::memory_order_relaxed);
+        }
+    }
+
+    std::mutex                  mutex_;
+    std::vector<detail::Slot *> live_;
+    Snapshot                    retired_;
+};
+
+Registry &
+registry() {
+    // Intentionally leaked so that threads exiting during static destruction can still detach.
+    static auto *instance = new Registry;
+    return *instance;
+}
+
+// Registers the calling thread's slot on first use and folds its totals into the registry when
+// the thread exits, so counts from short-lived worker threads are not lost.
+class Registration {
+public:
+    Registration() {
+        registry().attach(&slot);
+    }
+
+    Registration(const Registration &) = delete;
+
+    ~Registration() {
+        registry().detach(&slot);
+    }
+
+    detail::Slot slot;
+};
+
+} // namespace
+
+detail::Slot &
+detail::local() {
+    static thread_local Registration registration;
+    return registration.slot;
+}
+
+const char *
+name(Counter counter) {
+    switch (counter) {
+        case Counter::BoardNodes: return "board_nodes";
+        case Counter::Allocations: return "allocations";
+        case Counter::AllocatedBytes: return "allocated_bytes";
+        case Counter::InvalidPiece: return "invalid_piece";
+        case Counter::AtCalls: return "at_calls";
+        case Counter::AtDepth: return "at_depth";
+        case Counter::SearchNodes: return "search_nodes";
+        case Counter::Count: break;
+    }
+    return "unknown";
+}
+
+const char *
+name(Gauge gauge) {
+    switch (gauge) {
+        case Gauge::AtMaxDepth: return "at_max_depth";
+        case Gauge::Count: break;
+    }
+    return "unknown";
+}
+
+const char *
+name(Timer timer) {
+    switch (timer) {
+        case Timer::Search: return "search";
+        case Timer::Count: break;
+    }
+    return "unknown";
+}
+
+std::uint64_t
+Snapshot::operator[](Counter counter) const {
+    return counters[static_cast<std::size_t>(counter)];
+}
+
+std::uint64_t
+Snapshot::operator[](Gauge gauge) const {
+    return gauges[static_cast<std::size_t>(gauge)];
+}
+
+const Snapshot::TimerTotal &
+Snapshot::operator[](Timer timer) const {
+    return timers[static_cast<std::size_t>(timer)];
+}
+
+double
+Snapshot::averageAtDepth() const {
+    auto calls = (*this)[Counter::AtCalls];
+    return calls ? static_cast<double>((*this)[Counter::AtDepth]) / calls : 0.0;
+}
+
+double
+Snapshot::searchNodesPerSecond() const {
+    auto nanos = (*this)[Timer::Search].nanos;
+    return nanos ? static_cast<double>((*this)[Counter::SearchNodes]) * 1e9 / nanos : 0.0;
+}
+
+void
+Snapshot::toJson(std::ostream &os) const {
+    os << "{\"enabled\":" << (enabled ? "true" : "false") << ",\"counters\":{";
+    for (std::size_t i = 0; i < counterCount; i++) {
+        os << (i ? "," : "") << '"' << name(static_cast<Counter>(i)) << "\":" << counters[i];
+    }
+    os << "},\"gauges\":{";
+    for (std::size_t i = 0; i < gaugeCount; i++) {
+        os << (i ? "," : "") << '"' << name(static_cast<Gauge>(i)) << "\":" << gauges[i];
+    }
+    os << "},\"timers\":{";
+    for (std::size_t i = 0; i < timerCount; i++) {
+        os << (i ? "," : "") << '"' << name(static_cast<Timer>(i)) << "\":{\"calls\":"
+           << timers[i].calls << ",\"seconds\":" << static_cast<double>(timers[i].nanos) / 1e9
+           << "}";
+    }
+    os << "},\"at_average_depth\":" << averageAtDepth()
+       << ",\"search_nodes_per_second\":" << searchNodesPerSecond() << "}";
+}
+
+Snapshot
+snapshot() {
+    if constexpr (enabled) {
+        return registry().total();
+    } else {
+        return {};
+    }
+}
+
+void
+reset() {
+    if constexpr (enabled) registry().clear();
+}
+
+void
+dumpJson(std::ostream &os) {
+    snapshot().toJson(os);
+}
+
+} // namespace Chess::Stats
@@ -0,0 +1,75 @@
+//
+// Created by taylor-santos on 10/19/2026 at 04:20.
+//
+
+#include "timeman.h"
+
+#include <algorithm>
+
+namespace Chess {
+
+TimeManager::TimeManager(const TimeControl &control)
+    : score_{0}
+    , stableIterations_{0}
+    , instability_{0}
+    , failedLow_{false}
+    , onlyMove_{false} {
+    Duration left  = std::max<Duration>(control.remaining - overhead, Duration::zero());
+    Duration inc   = std::max<Duration>(control.increment, Duration::zero());
+    int      moves = control.movesToGo > 0 ? control.movesToGo : expectedMovesLeft;
+
+    // Never spend more than four fifths of the clock on one move, whatever the increment.
+    Duration limit = left * 4 / 5;
+    optimum_       = std::min(left / moves + inc * 3 / 4, limit);
+    maximum_       = std::min(optimum_ * 4, limit);
+}
+
+TimeManager::Duration
+TimeManager::optimum() const {
+    return optimum_;
+}
+
+TimeManager::Duration
+TimeManager::maximum() const {
+    return maximum_;
+}
+
+void
+TimeManager::iterationDone(const BasicMove &best, int score, std::size_t legalMoves) {
+    // Each change of best move counts for less the longer ago it was.
+    instability_ /= 2;
+    if (best_ && *best_ == best) {
+        stableIterations_++;
+    } else {
+        if (best_) instability_ += 1;
+        stableIterations_ = 0;
+    }
+    failedLow_ = best_ && score <= score_ - failLowMargin;
+    best_      = best;
+    score_     = score;
+    onlyMove_  = legalMoves == 1;
+}
+
+bool
+TimeManager::shouldStop(Duration elapsed) const {
+    if (onlyMove_) return true;
+    // Iterations take several times longer than the one before, so one started after 60% of the
+    // budget would most likely be cut off by outOfTime() and wasted.
+    auto budget = std::min(std::chrono::duration_cast<Duration>(optimum_ * scale()), maximum_);
+    return elapsed >= budget * 3 / 5;
+}
+
+bool
+TimeManager::outOfTime(Duration elapsed) const {
+    return elapsed >= maximum_;
+}
+
+double
+TimeManager::scale() const {
+    double scale = 1 + instability_;
+    if (failedLow_) scale *= 1.5;
+    if (!failedLow_ && stableIterations_ >= easyMoveIterations) scale *= 0.5;
+    return scale;
+}
+
+} // namespace Chess
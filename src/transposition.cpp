@@ -0,0 +1,91 @@
+//
+// Created by taylor-santos on 10/19/2026 at 04:52.
+//
+
+#include "transposition.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace Chess {
+
+TranspositionTable::TranspositionTable(std::size_t entries)
+    : generation_{0}
+    , epoch_{1} {
+    if (entries == 0) throw std::invalid_argument("TranspositionTable needs at least one entry");
+    std::size_t size = 1;
+    while (size <= entries / 2) {
+        size *= 2;
+    }
+    entries_.resize(size);
+}
+
+std::optional<TranspositionTable::Hit>
+TranspositionTable::probe(std::uint64_t key) const {
+    auto &entry = entries_[key & (entries_.size() - 1)];
+    if (!live(entry) || entry.check != static_cast<std::uint32_t>(key >> 32U)) return std::nullopt;
+
+    Hit hit{entry.score, entry.depth, entry.bound, std::nullopt};
+    if (entry.from >= 0) {
+        std::optional<Type> promotion;
+        if (entry.promotion) promotion = static_cast<Type>(entry.promotion - 1);
+        hit.move = BasicMove{entry.from, entry.to, promotion};
+    }
+    return hit;
+}
+
+void
+TranspositionTable::store(
+    std::uint64_t                   key,
+    int                             depth,
+    int                             score,
+    Bound                           bound,
+    const std::optional<BasicMove> &move) {
+    auto &entry = entries_[key & (entries_.size() - 1)];
+    auto  check = static_cast<std::uint32_t>(key >> 32U);
+    if (live(entry) && entry.generation == generation_ && entry.depth > depth) return;
+
+    // Keep the old move if this result has none, e.g. because every move failed low.
+    auto sameKey = live(entry) && entry.check == check;
+    entry.check  = check;
+    entry.score  = score;
+    entry.depth  = static_cast<std::int8_t>(depth);
+    entry.bound  = bound;
+    if (move) {
+        entry.from      = static_cast<std::int8_t>(move->from);
+        entry.to        = static_cast<std::int8_t>(move->to);
+        entry.promotion =
+            static_cast<std::uint8_t>(move->promotion ? static_cast<int>(*move->promotion) + 1 : 0);
+    } else if (!sameKey) {
+        entry.from = -1;
+    }
+    entry.generation = generation_;
+    entry.epoch      = epoch_;
+}
+
+void
+TranspositionTable::newSearch() {
+    generation_++;
+}
+
+void
+TranspositionTable::clear() {
+    generation_ = 0;
+    // Only once the epoch wraps around could an entry from an earlier epoch look current again.
+    if (++epoch_ == 0) {
+        std::fill(entries_.begin(), entries_.end(), Entry{});
+        epoch_ = 1;
+    }
+}
+
+std::size_t
+TranspositionTable::size() const {
+    return entries_.size();
+}
+
+bool
+TranspositionTable::live(const Entry &entry) const {
+    return entry.epoch == epoch_;
+}
+
+} // namespace Chess
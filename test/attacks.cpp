@@ -0,0 +1,180 @@
+//
+// Created by taylor-santos on 10/18/2026 at 15:31.
+//
+
+#include "gtest/gtest.h"
+#include "attacks.h"
+
+#include <random>
+
+#include "board.h"
+#include "boards.h"
+
+using namespace Chess;
+
+static Bitboard
+bits(std::initializer_list<Coord> coords) {
+    Bitboard result = 0;
+    for (auto coord : coords) {
+        result |= bitOf(coord);
+    }
+    return result;
+}
+
+TEST(AttackMap, SquareConversionsShouldRoundTrip) {
+    for (int square = 0; square < 64; square++) {
+        EXPECT_EQ(square, squareOf(coordOf(square)));
+        EXPECT_EQ(Bitboard{1} << square, bitOf(coordOf(square)));
+    }
+    EXPECT_EQ(0, squareOf({A, _1}));
+    EXPECT_EQ(63, squareOf({H, _8}));
+}
+
+TEST(AttackMap, RookOnEmptyBoardShouldAttackFileAndRank) {
+    AttackMap map{*makeBoard({{{A, _1}, {Type::Rook, Color::White}}})};
+    auto      attacks = map.attacksFrom({A, _1});
+    int       count   = 0;
+    for (auto remaining = attacks; remaining; remaining &= remaining - 1) count++;
+    EXPECT_EQ(14, count);
+    EXPECT_TRUE(attacks & bitOf({A, _8}));
+    EXPECT_TRUE(attacks & bitOf({H, _1}));
+    EXPECT_FALSE(attacks & bitOf({B, _2}));
+}
+
+TEST(AttackMap, RaysShouldStopAtFirstPiece) {
+    AttackMap map{*makeBoard({
+        {{A, _1}, {Type::Rook, Color::White}},
+        {{A, _3}, {Type::Pawn, Color::Black}},
+        {{C, _1}, {Type::Knight, Color::White}},
+    })};
+    EXPECT_EQ(bits({{A, _2}, {A, _3}, {B, _1}, {C, _1}}), map.attacksFrom({A, _1}));
+    EXPECT_EQ(bits({{A, _1}}), map.attackersOf({A, _3}, Color::White));
+    EXPECT_EQ(bits({{A, _1}}), map.defendersOf({C, _1}));
+    EXPECT_TRUE(map.isAttacked({B, _3}, Color::White));
+    EXPECT_FALSE(map.isAttacked({B, _3}, Color::Black));
+}
+
+TEST(AttackMap, PawnsShouldAttackDiagonallyForward) {
+    AttackMap map{*makeBoard({
+        {{D, _4}, {Type::Pawn, Color::White}},
+        {{D, _5}, {Type::Pawn, Color::Black}},
+    })};
+    EXPECT_EQ(bits({{C, _5}, {E, _5}}), map.attacksFrom({D, _4}));
+    EXPECT_EQ(bits({{C, _4}, {E, _4}}), map.attacksFrom({D, _5}));
+}
+
+TEST(AttackMap, LinkedPortalShouldContinueRayFromPartner) {
+    AttackMap map{*makeBoard({
+        {{A, _4}, {Type::Rook, Color::White}},
+        {{D, _4}, {Type::Portal, Color::White}},
+        {{F, _6}, {Type::Portal, Color::White}},
+    })};
+    ASSERT_TRUE(map.portalPartner({D, _4}));
+    EXPECT_EQ((Coord{F, _6}), *map.portalPartner({D, _4}));
+    auto attacks = map.attacksFrom({A, _4});
+    EXPECT_TRUE(attacks & bitOf({C, _4}));
+    EXPECT_FALSE(attacks & bitOf({D, _4}));
+    EXPECT_FALSE(attacks & bitOf({E, _4}));
+    EXPECT_TRUE(attacks & bitOf({G, _6}));
+    EXPECT_TRUE(attacks & bitOf({H, _6}));
+}
+
+TEST(AttackMap, UnlinkedPortalShouldBlockRay) {
+    AttackMap map{*makeBoard({
+        {{A, _4}, {Type::Rook, Color::White}},
+        {{D, _4}, {Type::Portal, Color::White}},
+        {{F, _6}, {Type::Portal, Color::Black}},
+    })};
+    EXPECT_FALSE(map.portalPartner({D, _4}));
+    auto attacks = map.attacksFrom({A, _4});
+    EXPECT_TRUE(attacks & bitOf({C, _4}));
+    EXPECT_FALSE(attacks & bitOf({D, _4}));
+    EXPECT_FALSE(attacks & bitOf({E, _4}));
+}
+
+TEST(AttackMap, KnightShouldLeapThroughPortal) {
+    AttackMap map{*makeBoard({
+        {{B, _1}, {Type::Knight, Color::Black}},
+        {{C, _3}, {Type::Portal, Color::Black}},
+        {{F, _5}, {Type::Portal, Color::Black}},
+    })};
+    // B1 + (1, 2) lands on the portal at C3, so the knight arrives at F5 + (1, 2) = G7.
+    EXPECT_EQ(bits({{A, _3}, {D, _2}, {G, _7}}), map.attacksFrom({B, _1}));
+}
+
+TEST(AttackMap, StepByOffsetShouldMatchStep) {
+    AttackMap map{*makeBoard({
+        {{C, _3}, {Type::Portal, Color::Black}},
+        {{F, _5}, {Type::Portal, Color::Black}},
+    })};
+    EXPECT_EQ(map.step({B, _1}, KnightFirst), map.step({B, _1}, 1, 2));
+    EXPECT_EQ((Coord{G, _7}), map.step({B, _1}, 1, 2));
+    EXPECT_EQ((Coord{A, _2}), map.step({B, _1}, -1, 1));
+    EXPECT_FALSE(map.step({H, _1}, 1, 0));
+    EXPECT_THROW((void)map.step({B, _1}, 2, 0), std::invalid_argument);
+}
+
+TEST(AttackMap, RayThroughPortalShouldNotAttackItsOrigin) {
+    AttackMap map{*makeBoard({
+        {{B, _1}, {Type::Rook, Color::White}},
+        {{A, _1}, {Type::Portal, Color::White}},
+        {{H, _2}, {Type::Portal, Color::White}},
+    })};
+    EXPECT_FALSE(map.attacksFrom({B, _1}) & bitOf({B, _1}));
+}
+
+TEST(AttackMap, AddingPortalShouldUpdateAffectedRays) {
+    AttackMap map{*makeBoard({
+        {{A, _4}, {Type::Rook, Color::White}},
+        {{D, _4}, {Type::Portal, Color::White}},
+    })};
+    EXPECT_FALSE(map.attacksFrom({A, _4}) & bitOf({H, _6}));
+    map.addPiece({F, _6}, {Type::Portal, Color::White});
+    EXPECT_TRUE(map.attacksFrom({A, _4}) & bitOf({H, _6}));
+    map.removePiece({F, _6});
+    EXPECT_FALSE(map.attacksFrom({A, _4}) & bitOf({H, _6}));
+    EXPECT_FALSE(map.attacksFrom({A, _4}) & bitOf({E, _4}));
+}
+
+TEST(AttackMap, InvalidUpdatesShouldThrowInvalidPiece) {
+    AttackMap map{*makeBoard({{{A, _1}, {Type::Rook, Color::White}}})};
+    EXPECT_THROW(map.addPiece({A, _1}, {Type::Pawn, Color::Black}), invalid_piece);
+    EXPECT_THROW(map.removePiece({B, _1}), invalid_piece);
+    EXPECT_THROW(map.movePiece({B, _1}, {C, _1}), invalid_piece);
+    map.addPiece({C, _1}, {Type::Pawn, Color::Black});
+    EXPECT_THROW(map.movePiece({A, _1}, {C, _1}), invalid_piece);
+}
+
+TEST(AttackMap, IncrementalUpdatesShouldMatchFullRecomputation) {
+    std::mt19937 rng{12345};
+    auto         board = Board::make({});
+    AttackMap    map{*board};
+
+    Type types[] =
+        {Type::Bishop, Type::King, Type::Knight, Type::Pawn, Type::Portal, Type::Queen, Type::Rook};
+    for (int i = 0; i < 3000; i++) {
+        auto from  = coordOf(static_cast<int>(rng() % 64));
+        auto to    = coordOf(static_cast<int>(rng() % 64));
+        auto piece = Piece{types[rng() % 7], rng() % 2 ? Color::White : Color::Black};
+        if (!board->at(from)) {
+            board = board->addPiece(from, std::make_unique<Piece>(piece));
+            map.addPiece(from, piece);
+        } else if (!board->at(to)) {
+            board = board->movePiece(from, to);
+            map.movePiece(from, to);
+        } else {
+            board = board->removePiece(from);
+            map.removePiece(from);
+        }
+
+        AttackMap fresh{*board};
+        for (int square = 0; square < 64; square++) {
+            auto coord = coordOf(square);
+            ASSERT_EQ(fresh.attacksFrom(coord), map.attacksFrom(coord)) << "step " << i;
+            for (auto color : {Color::White, Color::Black}) {
+                ASSERT_EQ(fresh.attackersOf(coord, color), map.attackersOf(coord, color));
+            }
+            ASSERT_EQ(fresh.portalPartner(coord), map.portalPartner(coord));
+        }
+    }
+}
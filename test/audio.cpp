@@ -0,0 +1,348 @@
+//
+// Created by taylor-santos on 10/19/2026 at 03:30.
+//
+
+#include "audio.h"
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <thread>
+
+using namespace Chess::Audio;
+
+static Sound
+tone(unsigned channels, unsigned sampleRate, std::size_t frames, std::int16_t amplitude) {
+    Sound sound{channels, sampleRate, {}};
+    for (std::size_t i = 0; i < frames * channels; i++) {
+        sound.samples.push_back(static_cast<std::int16_t>(i % 2 ? -amplitude : amplitude));
+    }
+    return sound;
+}
+
+// A WAV file with the given fmt fields and raw sample bytes.
+static std::vector<std::uint8_t>
+wavFile(unsigned format, unsigned channels, unsigned bits, const std::vector<std::uint8_t> &data) {
+    auto bytes = encodeWav(Sound{channels, 8000, {}});
+    bytes[20]  = static_cast<std::uint8_t>(format);
+    bytes[34]  = static_cast<std::uint8_t>(bits);
+    bytes[40]  = static_cast<std::uint8_t>(data.size());
+    bytes.insert(bytes.end(), data.begin(), data.end());
+    return bytes;
+}
+
+TEST(Audio, WavRoundTrips) {
+    auto sound   = tone(1, 22050, 100, 1234);
+    auto decoded = decode(encodeWav(sound));
+    EXPECT_EQ(1U, decoded.channels);
+    EXPECT_EQ(22050U, decoded.sampleRate);
+    EXPECT_EQ(sound.samples, decoded.samples);
+    EXPECT_EQ(100U, decoded.frames());
+}
+
+TEST(Audio, DecodesOtherSampleFormats) {
+    auto eightBit = decodeWav(wavFile(1, 1, 8, {0, 128, 255}));
+    EXPECT_EQ((std::vector<std::int16_t>{-32768, 0, 32512}), eightBit.samples);
+
+    auto wide = decodeWav(wavFile(1, 1, 24, {0xFF, 0x34, 0x12, 0x00, 0x00, 0x80}));
+    EXPECT_EQ((std::vector<std::int16_t>{0x1234, -32768}), wide.samples);
+
+    std::vector<std::uint8_t> floats(20);
+    float values[] = {0.5f, -1.0f, 2.0f, -1e30f, std::numeric_limits<float>::infinity()};
+    std::memcpy(floats.data(), values, sizeof(values));
+    auto decoded = decodeWav(wavFile(3, 1, 32, floats));
+    EXPECT_EQ((std::vector<std::int16_t>{16384, -32767, 32767, -32767, 32767}), decoded.samples);
+
+    float nan = std::numeric_limits<float>::quiet_NaN();
+    std::memcpy(floats.data(), &nan, sizeof(nan));
+    EXPECT_THROW(decodeWav(wavFile(3, 1, 32, floats)), std::runtime_error);
+}
+
+TEST(Audio, DecodeRejectsInvalidData) {
+    EXPECT_THROW((void)decode({}), std::runtime_error);
+    std::vector<std::uint8_t> avi{'R', 'I', 'F', 'F', 0, 0, 0, 0, 'A', 'V', 'I', ' '};
+    EXPECT_THROW((void)decode(avi), std::runtime_error);
+    EXPECT_THROW((void)decodeWav(wavFile(2, 1, 4, {0, 0})), std::runtime_error);
+
+    auto truncated = encodeWav(tone(1, 8000, 10, 1));
+    truncated.resize(36);
+    EXPECT_THROW((void)decodeWav(truncated), std::runtime_error);
+}
+
+TEST(Audio, OggNeedsStbVorbis) {
+    if (oggSupported) GTEST_SKIP() << "OGG Vorbis support is built in";
+    std::vector<std::uint8_t> ogg{'O', 'g', 'g', 'S', 0, 2};
+    EXPECT_THROW((void)decode(ogg), std::runtime_error);
+}
+
+TEST(Audio, ResampleConvertsToStereo) {
+    Sound mono{1, 8000, {0, 100, 200}};
+    auto  same = resample(mono, 8000);
+    EXPECT_EQ(2U, same.channels);
+    EXPECT_EQ((std::vector<std::int16_t>{0, 0, 100, 100, 200, 200}), same.samples);
+
+    auto doubled = resample(mono, 16000);
+    EXPECT_EQ(16000U, doubled.sampleRate);
+    EXPECT_EQ(
+        (std::vector<std::int16_t>{0, 0, 50, 50, 100, 100, 150, 150, 200, 200, 200, 200}),
+        doubled.samples);
+
+    Sound surround{3, 8000, {1, 2, 3, 4, 5, 6}};
+    EXPECT_EQ((std::vector<std::int16_t>{1, 2, 4, 5}), resample(surround, 8000).samples);
+
+    EXPECT_THROW((void)resample(mono, 0), std::invalid_argument);
+}
+
+TEST(Audio, SoundBankConvertsOnAdd) {
+    SoundBank bank{16000};
+    auto      move = bank.add("move", tone(1, 8000, 50, 1000));
+    auto      take = bank.add("capture", tone(2, 16000, 20, 2000));
+    EXPECT_EQ(2U, bank.size());
+    EXPECT_EQ(move, bank.find("move"));
+    EXPECT_EQ(take, bank.find("capture"));
+    EXPECT_FALSE(bank.find("check"));
+    EXPECT_EQ(2U, bank[move].channels);
+    EXPECT_EQ(16000U, bank[move].sampleRate);
+    EXPECT_EQ(100U, bank[move].frames());
+    EXPECT_THROW(bank.add("move", tone(1, 8000, 1, 1)), std::invalid_argument);
+}
+
+TEST(Audio, DecodesBundledSoundEffects) {
+    auto          path = std::filesystem::path{PORTAL_CHESS_SFX_DIR} / "standard" / "std_move.wav";
+    std::ifstream file{path, std::ios::binary};
+    ASSERT_TRUE(file) << path;
+    std::vector<std::uint8_t> bytes{std::istreambuf_iterator<char>{file}, {}};
+
+    auto sound = decode(bytes);
+    EXPECT_EQ(2U, sound.channels);
+    EXPECT_EQ(48000U, sound.sampleRate);
+    EXPECT_EQ(36000U, sound.frames());
+    EXPECT_TRUE(std::any_of(sound.samples.begin(), sound.samples.end(), [](std::int16_t sample) {
+        return sample != 0;
+    }));
+
+    SoundBank bank{48000};
+    EXPECT_EQ(1U, bank.loadDirectory(path.parent_path()));
+    EXPECT_TRUE(bank.find("std_move"));
+}
+
+TEST(Audio, LoadDirectoryReportsUndecodableFiles) {
+    auto directory = std::filesystem::temp_directory_path() / "portal_chess_sfx_test";
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directory(directory);
+    auto writeFile = [&](const char *name, const std::vector<std::uint8_t> &bytes) {
+        std::ofstream file{directory / name, std::ios::binary};
+        file.write(reinterpret_cast<const char *>(bytes.data()), bytes.size());
+    };
+    writeFile("a_click.wav", encodeWav(tone(1, 8000, 10, 1)));
+    writeFile("notes.txt", {'h', 'i'});
+    writeFile("z_broken.ogg", {'O', 'g', 'g', 'S', 0, 2});
+
+    SoundBank bank{8000};
+    try {
+        (void)bank.loadDirectory(directory);
+        ADD_FAILURE() << "loadDirectory() accepted an undecodable file";
+    } catch (const std::runtime_error &e) {
+        EXPECT_NE(std::string::npos, std::string{e.what()}.find("z_broken.ogg"));
+    }
+    EXPECT_TRUE(bank.find("a_click"));
+
+    std::filesystem::remove(directory / "z_broken.ogg");
+    SoundBank clean{8000};
+    EXPECT_EQ(1U, clean.loadDirectory(directory));
+    std::filesystem::remove_all(directory);
+}
+
+TEST(SpscQueue, FifoAndBounded) {
+    SpscQueue<int, 4> queue;
+    EXPECT_FALSE(queue.tryPop());
+    for (int i = 0; i < 4; i++) {
+        EXPECT_TRUE(queue.tryPush(i));
+    }
+    EXPECT_FALSE(queue.tryPush(4));
+    EXPECT_EQ(0, queue.tryPop());
+    EXPECT_TRUE(queue.tryPush(4));
+    for (int i = 1; i <= 4; i++) {
+        EXPECT_EQ(i, queue.tryPop());
+    }
+    EXPECT_FALSE(queue.tryPop());
+}
+
+TEST(SpscQueue, TransfersAcrossThreads) {
+    SpscQueue<int, 64> queue;
+    constexpr int      count = 100000;
+    std::thread        producer{[&] {
+        for (int i = 0; i < count;) {
+            if (queue.tryPush(i)) {
+                i++;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    }};
+    int  expected = 0;
+    bool ordered  = true;
+    while (expected < count) {
+        if (auto item = queue.tryPop()) {
+            ordered &= *item == expected++;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+    EXPECT_TRUE(ordered);
+}
+
+TEST(Mixer, RendersSilenceWhenIdle) {
+    SoundBank                 bank{8000};
+    Mixer                     mixer{bank};
+    std::vector<std::int16_t> block(64, 1);
+    mixer.render(block.data(), 32);
+    EXPECT_EQ(std::vector<std::int16_t>(64, 0), block);
+}
+
+TEST(Mixer, MixesAndClips) {
+    SoundBank bank{8000};
+    auto      quiet = bank.add("quiet", Sound{2, 8000, {100, -100, 100, -100}});
+    auto      loud  = bank.add("loud", Sound{2, 8000, {32700, -32700}});
+    Mixer     mixer{bank};
+
+    EXPECT_TRUE(mixer.play(quiet));
+    EXPECT_TRUE(mixer.play(loud));
+    EXPECT_TRUE(mixer.play(quiet, 0.5f));
+    std::vector<std::int16_t> block(6);
+    mixer.render(block.data(), 3);
+    EXPECT_EQ((std::vector<std::int16_t>{32767, -32768, 150, -150, 0, 0}), block);
+    EXPECT_EQ(0U, mixer.activeVoices());
+}
+
+TEST(Mixer, ClampsGain) {
+    SoundBank bank{8000};
+    auto      id = bank.add("click", Sound{2, 8000, {100, -100}});
+    Mixer     mixer{bank};
+
+    EXPECT_TRUE(mixer.play(id, 1e30f));
+    EXPECT_TRUE(mixer.play(id, -2.0f));
+    EXPECT_TRUE(mixer.play(id, std::numeric_limits<float>::quiet_NaN()));
+    std::vector<std::int16_t> block(2);
+    mixer.render(block.data(), 1);
+    EXPECT_EQ(
+        (std::vector<std::int16_t>{
+            static_cast<std::int16_t>(100 * Mixer::maxGain),
+            static_cast<std::int16_t>(-100 * Mixer::maxGain)}),
+        block);
+}
+
+TEST(Mixer, SoundsContinueAcrossBlocks) {
+    SoundBank bank{8000};
+    auto      id = bank.add("long", tone(2, 8000, 1000, 500));
+    Mixer     mixer{bank};
+    mixer.play(id);
+
+    std::vector<std::int16_t> block(2 * 300);
+    for (int i = 0; i < 3; i++) {
+        mixer.render(block.data(), 300);
+        EXPECT_EQ(1U, mixer.activeVoices());
+        EXPECT_EQ(-500, block.back());
+    }
+    mixer.render(block.data(), 300);
+    EXPECT_EQ(0U, mixer.activeVoices());
+    EXPECT_EQ(500, block[2 * 100 - 2]);
+    EXPECT_EQ(0, block[2 * 100]);
+}
+
+TEST(Mixer, StopAllAndVoiceStealing) {
+    SoundBank bank{8000};
+    auto      id = bank.add("long", tone(2, 8000, 1000, 1));
+    Mixer     mixer{bank};
+
+    std::vector<std::int16_t> block(2);
+    for (std::size_t i = 0; i < Mixer::maxVoices + 5; i++) {
+        mixer.play(id);
+        mixer.render(block.data(), 1);
+    }
+    EXPECT_EQ(Mixer::maxVoices, mixer.activeVoices());
+
+    mixer.stopAll();
+    mixer.render(block.data(), 1);
+    EXPECT_EQ(0U, mixer.activeVoices());
+    EXPECT_EQ(0, block[0]);
+}
+
+TEST(Mixer, PlayFailsWhenQueueIsFull) {
+    SoundBank bank{8000};
+    auto      id = bank.add("click", tone(2, 8000, 1, 1));
+    Mixer     mixer{bank};
+    for (std::size_t i = 0; i < Mixer::commandCapacity; i++) {
+        EXPECT_TRUE(mixer.play(id));
+    }
+    EXPECT_FALSE(mixer.play(id));
+    EXPECT_THROW(mixer.play(id + 1), std::out_of_range);
+}
+
+TEST(AudioThread, NullOutputRunsInRealTime) {
+    SoundBank bank{48000};
+    Mixer     mixer{bank};
+    auto      output = std::make_unique<NullOutput>(48000);
+    auto     &null   = *output;
+
+    auto start = std::chrono::steady_clock::now();
+    {
+        AudioThread thread{mixer, std::move(output), 480};
+        while (null.framesWritten() < 4800) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+    // 4800 frames is 100 ms of audio, and only the first block is accepted immediately.
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(85));
+}
+
+TEST(AudioThread, FileOutputRecordsPlayedSounds) {
+    auto path = std::filesystem::temp_directory_path() / "portal_chess_audio_test.wav";
+    {
+        SoundBank bank{8000};
+        auto      id = bank.add("click", tone(2, 8000, 16, 7000));
+        Mixer     mixer{bank};
+        {
+            auto        output = std::make_unique<FileOutput>(path, 8000, false);
+            auto       &file   = *output;
+            AudioThread thread{mixer, std::move(output), 64};
+            auto        waitFor = [&](std::uint64_t frames) {
+                while (file.framesWritten() < frames) {
+                    std::this_thread::yield();
+                }
+            };
+            waitFor(128);
+            // Up to two blocks rendered before play() may miss the sound, but the third has it.
+            auto played = file.framesWritten();
+            mixer.play(id);
+            waitFor(played + 3 * 64);
+        }
+        EXPECT_THROW(
+            (AudioThread{mixer, std::make_unique<NullOutput>(44100)}),
+            std::invalid_argument);
+    }
+
+    std::ifstream file{path, std::ios::binary};
+    auto          recorded =
+        decodeWav({std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}});
+    file.close();
+    std::filesystem::remove(path);
+
+    EXPECT_EQ(2U, recorded.channels);
+    EXPECT_EQ(8000U, recorded.sampleRate);
+    EXPECT_EQ(0U, recorded.frames() % 64);
+    auto first = std::find(recorded.samples.begin(), recorded.samples.end(), 7000);
+    ASSERT_NE(recorded.samples.end(), first);
+    // The whole sound was written, and nothing else.
+    EXPECT_EQ(tone(2, 8000, 16, 7000).samples, std::vector<std::int16_t>(first, first + 32));
+    EXPECT_EQ(
+        32,
+        std::count_if(recorded.samples.begin(), recorded.samples.end(), [](auto s) {
+            return s != 0;
+        }));
+}
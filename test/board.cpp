@@ -178,3 +178,142 @@ TEST(Board, MovePieceDoesNotMutateBoard) {
     EXPECT_TRUE(board1->at(coord1));
     EXPECT_FALSE(board1->at(coord2));
 }
+
+TEST(Board, DestroyingLongHistoryShouldNotOverflowStack) {
+    Coord coord{A, _1};
+    auto  board = Board::make({});
+    for (int i = 0; i < 500000; i++) {
+        board = board->addPiece(coord, std::make_unique<Piece>(Type::Pawn, Color::White));
+        board = board->removePiece(coord);
+    }
+    EXPECT_NO_THROW(board.reset());
+}
+
+TEST(Board, DestroyingBranchShouldNotDestroySharedHistory) {
+    Coord from{A, _1};
+    Coord to{A, _2};
+    Piece piece{Type::Rook, Color::White};
+
+    std::vector<std::pair<Coord, incomplete_ptr<Piece>>> pieces;
+    pieces.emplace_back(from, std::make_unique<Piece>(piece));
+    auto root  = Board::make(std::move(pieces));
+    auto trunk = root->movePiece(from, to);
+    {
+        auto branch = trunk->movePiece(to, from)->movePiece(from, to);
+        EXPECT_TRUE(branch->at(to));
+    }
+    auto optPiece = trunk->at(to);
+    ASSERT_TRUE(optPiece);
+    EXPECT_EQ(piece, **optPiece);
+}
+
+TEST(Board, FlattenShouldPreservePieces) {
+    Coord coord1{A, _1}, coord2{H, _8};
+    Piece piece1{Type::Queen, Color::White};
+    Piece piece2{Type::Portal, Color::Black};
+
+    std::vector<std::pair<Coord, incomplete_ptr<Piece>>> pieces;
+    pieces.emplace_back(coord1, std::make_unique<Piece>(piece1));
+    auto board = Board::make(std::move(pieces));
+    board      = board->addPiece(coord2, std::make_unique<Piece>(piece2));
+    board      = board->movePiece(coord1, {B, _3});
+
+    auto flat = board->flatten();
+    EXPECT_LT(flat->historyBytes(), board->historyBytes());
+    EXPECT_FALSE(flat->at(coord1));
+    auto optPiece1 = flat->at({B, _3});
+    ASSERT_TRUE(optPiece1);
+    EXPECT_EQ(piece1, **optPiece1);
+    auto optPiece2 = flat->at(coord2);
+    ASSERT_TRUE(optPiece2);
+    EXPECT_EQ(piece2, **optPiece2);
+}
+
+TEST(Board, HistoryBudgetShouldReleaseOldHistory) {
+    Coord from{A, _1};
+    Coord to{A, _2};
+    Piece piece{Type::King, Color::Black};
+
+    std::vector<std::pair<Coord, incomplete_ptr<Piece>>> pieces;
+    pieces.emplace_back(from, std::make_unique<Piece>(piece));
+    std::size_t budget = 16 * 1024;
+    auto        board  = Board::make(std::move(pieces), budget);
+
+    std::weak_ptr<const Board> root = board;
+    for (int i = 0; i < 1000; i++) {
+        board = board->movePiece(from, to);
+        std::swap(from, to);
+        EXPECT_LE(board->historyBytes(), budget);
+    }
+    EXPECT_TRUE(root.expired());
+    auto optPiece = board->at(from);
+    ASSERT_TRUE(optPiece);
+    EXPECT_EQ(piece, **optPiece);
+    EXPECT_FALSE(board->at(to));
+}
+
+TEST(Board, HashShouldNotDependOnHistory) {
+    Piece rook{Type::Rook, Color::White};
+    Piece knight{Type::Knight, Color::Black};
+
+    auto board1 = Board::make({});
+    board1      = board1->addPiece({A, _1}, std::make_unique<Piece>(rook));
+    board1      = board1->addPiece({B, _1}, std::make_unique<Piece>(knight));
+
+    auto board2 = Board::make({});
+    board2      = board2->addPiece({B, _1}, std::make_unique<Piece>(knight));
+    board2      = board2->addPiece({C, _3}, std::make_unique<Piece>(rook));
+    board2      = board2->movePiece({C, _3}, {A, _1});
+
+    EXPECT_EQ(board1->hash(), board2->hash());
+    EXPECT_EQ(*board1, *board2);
+    EXPECT_EQ(board1->hash(), board1->flatten()->hash());
+}
+
+TEST(Board, DifferentPiecesShouldNotBeEqual) {
+    auto board1 = Board::make({});
+    board1      = board1->addPiece({A, _1}, std::make_unique<Piece>(Type::Rook, Color::White));
+    auto board2 = Board::make({});
+    board2      = board2->addPiece({A, _1}, std::make_unique<Piece>(Type::Rook, Color::Black));
+    auto board3 = board1->removePiece({A, _1});
+
+    EXPECT_NE(board1->hash(), board2->hash());
+    EXPECT_NE(*board1, *board2);
+    EXPECT_NE(*board1, *board3);
+    EXPECT_EQ(*board3, *Board::make({}));
+}
+
+TEST(Board, BranchShouldHaveSamePieces) {
+    Coord coord{D, _4};
+    Piece piece{Type::Knight, Color::White};
+
+    std::vector<std::pair<Coord, incomplete_ptr<Piece>>> pieces;
+    pieces.emplace_back(coord, std::make_unique<Piece>(piece));
+    auto shared = Board::make(std::move(pieces));
+    auto branch = shared->branch();
+
+    EXPECT_EQ(*shared, *branch);
+    EXPECT_EQ(shared->hash(), branch->hash());
+    auto optPiece = branch->at(coord);
+    ASSERT_TRUE(optPiece);
+    EXPECT_EQ(piece, **optPiece);
+}
+
+TEST(Board, BranchShouldHoldOneReferenceToSharedBoard) {
+    Coord from{D, _4};
+    Coord to{E, _6};
+
+    std::vector<std::pair<Coord, incomplete_ptr<Piece>>> pieces;
+    pieces.emplace_back(from, std::make_unique<Piece>(Type::Knight, Color::White));
+    auto shared = Board::make(std::move(pieces));
+    auto branch = shared->branch();
+    EXPECT_EQ(2, shared.use_count());
+
+    std::vector<std::shared_ptr<const Board>> children;
+    for (int i = 0; i < 8; i++) {
+        children.push_back(branch->movePiece(from, to));
+    }
+    EXPECT_EQ(2, shared.use_count());
+    EXPECT_FALSE(children.back()->at(from));
+    EXPECT_TRUE(shared->at(from));
+}
@@ -0,0 +1,32 @@
+//
+// Created by taylor-santos on 10/19/2026 at 14:05.
+//
+
+#ifndef PORTAL_CHESS_TEST_BOARDS_H
+#define PORTAL_CHESS_TEST_BOARDS_H
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "board.h"
+
+namespace Chess {
+
+/***
+ * Build a Board holding the listed pieces, for tests that place pieces by hand.
+ * @param list the pieces and their coordinates
+ * @returns the new Board
+ */
+inline std::shared_ptr<const Board>
+makeBoard(std::vector<std::pair<Coord, Piece>> list) {
+    std::vector<std::pair<Coord, incomplete_ptr<Piece>>> pieces;
+    for (auto &[coord, piece] : list) {
+        pieces.emplace_back(coord, std::make_unique<Piece>(piece));
+    }
+    return Board::make(std::move(pieces));
+}
+
+} // namespace Chess
+
+#endif // PORTAL_CHESS_TEST_BOARDS_H
@@ -0,0 +1,155 @@
+//
+// Created by taylor-santos on 10/18/2026 at 21:15.
+//
+
+#include "gtest/gtest.h"
+#include "diff.h"
+
+#include <random>
+
+#include "attacks.h"
+#include "piece.h"
+#include "stats.h"
+
+using namespace Chess;
+
+static std::shared_ptr<const Board>
+add(const std::shared_ptr<const Board> &board, Coord coord, Type type, Color color) {
+    return board->addPiece(coord, std::make_unique<Piece>(type, color));
+}
+
+// Compare every coordinate through at(), as diff() does when the Boards share no history.
+static std::vector<Coord>
+changedCoords(const Board &from, const Board &to) {
+    std::vector<Coord> coords;
+    for (int square = 0; square < 64; square++) {
+        auto coord  = coordOf(square);
+        auto before = from.at(coord);
+        auto after  = to.at(coord);
+        if (before.has_value() != after.has_value() || (before && **before != **after)) {
+            coords.push_back(coord);
+        }
+    }
+    return coords;
+}
+
+static std::vector<Coord>
+coordsOf(const std::vector<SquareChange> &changes) {
+    std::vector<Coord> coords;
+    for (auto &change : changes) {
+        coords.push_back(change.coord);
+    }
+    return coords;
+}
+
+TEST(Diff, SameBoardHasNoChanges) {
+    auto board = add(Board::make({}), {A, _1}, Type::Rook, Color::White);
+    EXPECT_TRUE(diff(*board, *board).empty());
+    EXPECT_TRUE(diff(*board, *board->branch()).empty());
+}
+
+TEST(Diff, MoveReportsBothCoordinates) {
+    auto before = add(Board::make({}), {A, _1}, Type::Rook, Color::White);
+    auto after  = before->movePiece({A, _1}, {A, _5});
+
+    auto changes = diff(*before, *after);
+    ASSERT_EQ(2, changes.size());
+    EXPECT_EQ((Coord{A, _1}), changes[0].coord);
+    EXPECT_EQ((Piece{Type::Rook, Color::White}), **changes[0].before);
+    EXPECT_FALSE(changes[0].after);
+    EXPECT_EQ((Coord{A, _5}), changes[1].coord);
+    EXPECT_FALSE(changes[1].before);
+    EXPECT_EQ((Piece{Type::Rook, Color::White}), **changes[1].after);
+
+    auto reverse = diff(*after, *before);
+    ASSERT_EQ(2, reverse.size());
+    EXPECT_FALSE(reverse[0].before);
+    EXPECT_TRUE(reverse[0].after);
+}
+
+TEST(Diff, SiblingsReportChangesOnBothSides) {
+    auto root  = add(Board::make({}), {E, _1}, Type::King, Color::White);
+    root       = add(root, {E, _8}, Type::King, Color::Black);
+    auto left  = root->movePiece({E, _1}, {D, _1});
+    auto right = add(root, {H, _4}, Type::Queen, Color::Black);
+
+    EXPECT_EQ((std::vector<Coord>{{D, _1}, {E, _1}, {H, _4}}), coordsOf(diff(*left, *right)));
+}
+
+TEST(Diff, UndoneChangesAreNotReported) {
+    auto root  = add(Board::make({}), {C, _3}, Type::Knight, Color::Black);
+    auto there = root->movePiece({C, _3}, {D, _5});
+    auto back  = there->movePiece({D, _5}, {C, _3});
+    EXPECT_TRUE(diff(*root, *back).empty());
+
+    auto replaced = root->removePiece({C, _3});
+    replaced      = add(replaced, {C, _3}, Type::Knight, Color::White);
+    EXPECT_EQ((std::vector<Coord>{{C, _3}}), coordsOf(diff(*root, *replaced)));
+}
+
+TEST(Diff, UnrelatedBoardsCompareEverySquare) {
+    auto first  = add(Board::make({}), {B, _2}, Type::Pawn, Color::White);
+    auto second = add(Board::make({}), {B, _2}, Type::Pawn, Color::White);
+    EXPECT_TRUE(diff(*first, *second).empty());
+
+    second = add(second, {G, _7}, Type::Pawn, Color::Black);
+    EXPECT_EQ((std::vector<Coord>{{G, _7}}), coordsOf(diff(*first, *second)));
+    EXPECT_EQ(
+        (std::vector<Coord>{{G, _7}}),
+        coordsOf(diff(*first->flatten(), *second->flatten())));
+}
+
+TEST(Diff, OnlyVisitsHistorySinceCommonAncestor) {
+    auto board = add(Board::make({}), {A, _1}, Type::Rook, Color::White);
+    for (int i = 0; i < 500; i++) {
+        board = board->movePiece({A, _1}, {A, _2})->movePiece({A, _2}, {A, _1});
+    }
+    auto next   = board->movePiece({A, _1}, {H, _1});
+    auto branch = board->branch();
+
+    // None of the 1000 moves before the common ancestor are visited.
+    EXPECT_EQ(1U, historyDistance(*board, *next));
+    EXPECT_EQ(2U, historyDistance(*next, *branch));
+    EXPECT_EQ(0U, historyDistance(*board, *board));
+    EXPECT_FALSE(historyDistance(*board, *board->flatten()));
+
+    Stats::reset();
+    auto changes = diff(*branch, *next);
+    ASSERT_EQ(2, changes.size());
+    EXPECT_EQ((Piece{Type::Rook, Color::White}), **changes[0].before);
+    EXPECT_EQ((Piece{Type::Rook, Color::White}), **changes[1].after);
+    // Each node records the pieces it changed, so no coordinate is looked up at all.
+    if (Stats::enabled) {
+        EXPECT_EQ(0, Stats::snapshot()[Stats::Counter::AtCalls]);
+    }
+}
+
+TEST(Diff, MatchesFullComparison) {
+    std::mt19937 rng{2034};
+    Type         types[] = {Type::Bishop, Type::King, Type::Knight, Type::Pawn, Type::Queen};
+
+    auto walk = [&](std::shared_ptr<const Board> board, int steps) {
+        for (int i = 0; i < steps; i++) {
+            auto from = coordOf(static_cast<int>(rng() % 64));
+            auto to   = coordOf(static_cast<int>(rng() % 64));
+            if (!board->at(from)) {
+                auto color = rng() % 2 ? Color::White : Color::Black;
+                board      = add(board, from, types[rng() % 5], color);
+            } else if (!board->at(to)) {
+                board = board->movePiece(from, to);
+            } else {
+                board = board->removePiece(from);
+            }
+            if (rng() % 16 == 0) board = board->branch();
+        }
+        return board;
+    };
+
+    for (int trial = 0; trial < 200; trial++) {
+        auto root  = walk(Board::make({}), 20);
+        auto left  = walk(root, static_cast<int>(rng() % 30));
+        auto right = walk(rng() % 4 ? root : root->flatten(), static_cast<int>(rng() % 30));
+        ASSERT_EQ(changedCoords(*left, *right), coordsOf(diff(*left, *right)))
+            << "trial " << trial;
+    }
+}
@@ -0,0 +1,172 @@
+//
+// Created by taylor-santos on 10/18/2026 at 20:25.
+//
+
+#include "gtest/gtest.h"
+#include "geometry.h"
+
+#include <algorithm>
+#include <random>
+#include <type_traits>
+
+#include "attacks.h"
+#include "movegen.h"
+
+using namespace Chess;
+
+using Grand = Geometry<10, 10>;
+
+static Grand::Mask
+squares(std::initializer_list<int> list) {
+    Grand::Mask result{0};
+    for (auto square : list) {
+        result |= Grand::bit(square);
+    }
+    return result;
+}
+
+TEST(Geometry, MaskTypeDependsOnSquareCount) {
+    EXPECT_TRUE((std::is_same_v<StandardGeometry::Mask, std::uint64_t>));
+    EXPECT_TRUE((std::is_same_v<Geometry<8, 6>::Mask, std::uint64_t>));
+    EXPECT_TRUE((std::is_same_v<Grand::Mask, WideMask<100>>));
+}
+
+TEST(Geometry, NeighborsStopAtEdges) {
+    static_assert(Grand::neighbor(0, North) == 10);
+    EXPECT_EQ(-1, Grand::neighbor(0, West));
+    EXPECT_EQ(-1, Grand::neighbor(0, SouthEast));
+    EXPECT_EQ(11, Grand::neighbor(0, NorthEast));
+    EXPECT_EQ(-1, Grand::neighbor(99, North));
+    EXPECT_EQ(98, Grand::neighbor(99, West));
+    EXPECT_EQ(-1, StandardGeometry::neighbor(7, East));
+    EXPECT_EQ(18, (Geometry<10, 8>::neighbor(9, NorthWest)));
+
+    std::vector<int> knight;
+    for (int step = KnightFirst; step < StepCount; step++) {
+        auto to = Grand::neighbor(0, static_cast<Step>(step));
+        if (to >= 0) knight.push_back(to);
+    }
+    std::sort(knight.begin(), knight.end());
+    EXPECT_EQ((std::vector<int>{12, 21}), knight);
+}
+
+TEST(Geometry, WideMaskBehavesLikeAnInteger) {
+    auto mask = squares({3, 64, 99});
+    EXPECT_TRUE(mask);
+    EXPECT_FALSE(Grand::Mask{0});
+    EXPECT_EQ(3, countSquares(mask));
+    EXPECT_EQ(3, lowestSquare(mask));
+    EXPECT_EQ(squares({64}), mask & squares({64, 65}));
+    EXPECT_EQ(100, countSquares(~Grand::Mask{0}));
+    EXPECT_EQ(97, countSquares(~mask));
+    EXPECT_EQ(squares({99}), WideMask<100>::bit(99));
+    EXPECT_EQ(std::uint64_t{1} << 63U, StandardGeometry::bit(63));
+
+    std::vector<int> visited;
+    forEachSquare(mask, [&](int square) { visited.push_back(square); });
+    EXPECT_EQ((std::vector<int>{3, 64, 99}), visited);
+}
+
+TEST(Geometry, RookAttacksCoverLargeBoard) {
+    BasicAttackMap<Grand> map{{{55, {Type::Rook, Color::White}}}};
+    EXPECT_EQ(18, countSquares(map.attacksFrom(55)));
+    EXPECT_TRUE(map.isAttacked(5, Color::White));
+    EXPECT_TRUE(map.isAttacked(95, Color::White));
+    EXPECT_TRUE(map.isAttacked(59, Color::White));
+}
+
+TEST(Geometry, PortalsLinkOnLargeBoard) {
+    // A rook on A1 sliding north runs into a portal on A5, exits past its partner on J9, and
+    // continues to J10.
+    BasicAttackMap<Grand> map{
+        {{0, {Type::Rook, Color::White}},
+         {40, {Type::Portal, Color::Black}},
+         {89, {Type::Portal, Color::Black}}}};
+    EXPECT_EQ(89, map.portalPartner(40));
+    EXPECT_EQ(squares({10, 20, 30, 99, 1, 2, 3, 4, 5, 6, 7, 8, 9}), map.attacksFrom(0));
+
+    map.removePiece(89);
+    EXPECT_EQ(-1, map.portalPartner(40));
+    EXPECT_FALSE(map.isAttacked(99, Color::White));
+}
+
+TEST(Geometry, PawnsPromoteOnLastRank) {
+    BasicAttackMap<Grand> map{
+        {{81, {Type::Pawn, Color::White}},
+         {0, {Type::King, Color::White}},
+         {99, {Type::King, Color::Black}}}};
+    auto moves = legalMoves(map, Color::White);
+    EXPECT_EQ(4, std::count_if(moves.begin(), moves.end(), [](const BasicMove &move) {
+                  return move.from == 81 && move.to == 91 && move.promotion;
+              }));
+
+    applyMove(map, {81, 91, Type::Queen});
+    EXPECT_EQ(Type::Queen, map.at(91)->type);
+    EXPECT_TRUE(inCheck(map, Color::Black));
+}
+
+TEST(Geometry, LegalMovesMatchMakeAndTestOnLargeBoard) {
+    std::mt19937 rng{2033};
+    Type         types[] =
+        {Type::Bishop, Type::Knight, Type::Pawn, Type::Portal, Type::Queen, Type::Rook};
+
+    for (int position = 0; position < 200; position++) {
+        std::vector<std::pair<int, Piece>> pieces;
+        auto                               occupied = [&](int square) {
+            return std::any_of(pieces.begin(), pieces.end(), [&](auto &entry) {
+                return entry.first == square;
+            });
+        };
+        for (auto color : {Color::White, Color::Black}) {
+            for (;;) {
+                auto square = static_cast<int>(rng() % Grand::squares);
+                if (occupied(square)) continue;
+                pieces.push_back({square, {Type::King, color}});
+                break;
+            }
+        }
+        for (int i = 0; i < 14; i++) {
+            auto square = static_cast<int>(rng() % Grand::squares);
+            if (occupied(square)) continue;
+            auto color = rng() % 2 ? Color::White : Color::Black;
+            pieces.push_back({square, {types[rng() % 6], color}});
+        }
+
+        BasicAttackMap<Grand> map{pieces};
+        for (auto color : {Color::White, Color::Black}) {
+            auto legal = legalMoves(map, color);
+            for (auto &move : pseudoLegalMoves(map, color)) {
+                auto after = map;
+                applyMove(after, move);
+                auto listed = std::find(legal.begin(), legal.end(), move) != legal.end();
+                ASSERT_EQ(!inCheck(after, color), listed)
+                    << "position " << position << " move " << move.from << "-" << move.to;
+            }
+        }
+    }
+}
+
+TEST(Geometry, MoveGenerationWorksOnAnyGeometry) {
+    // Neither geometry is compiled into the library: a 9x9 board needs a WideMask, a 6x6 board a
+    // std::uint64_t.
+    using Shogi = Geometry<9, 9>;
+    BasicAttackMap<Shogi> shogi{
+        {{40, {Type::Rook, Color::White}},
+         {0, {Type::King, Color::White}},
+         {80, {Type::King, Color::Black}}}};
+    EXPECT_EQ(16, countSquares(shogi.attacksFrom(40)));
+    EXPECT_EQ(16 + 3, legalMoves(shogi, Color::White).size());
+
+    using Los = Geometry<6, 6>;
+    BasicAttackMap<Los> los{
+        {{0, {Type::King, Color::White}},
+         {35, {Type::King, Color::Black}},
+         {30, {Type::Rook, Color::White}}}};
+    EXPECT_TRUE(inCheck(los, Color::Black));
+    // The king must leave the sixth rank, to E5 or F5.
+    auto moves = legalMoves(los, Color::Black);
+    ASSERT_EQ(2U, moves.size());
+    EXPECT_TRUE(std::all_of(moves.begin(), moves.end(), [](const BasicMove &move) {
+        return Los::rankOf(move.to) == 4;
+    }));
+}
@@ -0,0 +1,92 @@
+//
+// Created by taylor-santos on 10/18/2026 at 19:02.
+//
+
+#include "gtest/gtest.h"
+#include "history.h"
+
+#include <stdexcept>
+
+#include "board.h"
+#include "coord.h"
+#include "piece.h"
+
+using namespace Chess;
+
+TEST(PositionHistory, ShufflingKnightsShouldRepeat) {
+    std::vector<std::pair<Coord, incomplete_ptr<Piece>>> pieces;
+    pieces.emplace_back(Coord{G, _1}, std::make_unique<Piece>(Type::Knight, Color::White));
+    pieces.emplace_back(Coord{G, _8}, std::make_unique<Piece>(Type::Knight, Color::Black));
+    auto board = Board::make(std::move(pieces));
+
+    PositionHistory history{board->hash()};
+    for (int cycle = 1; cycle <= 2; cycle++) {
+        board = board->movePiece({G, _1}, {F, _3});
+        history.push(board->hash(), false);
+        board = board->movePiece({G, _8}, {F, _6});
+        history.push(board->hash(), false);
+        board = board->movePiece({F, _3}, {G, _1});
+        history.push(board->hash(), false);
+        EXPECT_FALSE(history.isThreefoldRepetition());
+        board = board->movePiece({F, _6}, {G, _8});
+        history.push(board->hash(), false);
+        EXPECT_EQ(cycle, history.repetitions());
+    }
+    EXPECT_TRUE(history.isThreefoldRepetition());
+    EXPECT_EQ(8, history.halfmoveClock());
+}
+
+TEST(PositionHistory, IrreversibleMoveShouldResetWindow) {
+    PositionHistory history{1};
+    history.push(2, false);
+    history.push(1, true);
+    history.push(2, false);
+    history.push(1, false);
+    EXPECT_EQ(1, history.repetitions());
+    EXPECT_EQ(2, history.halfmoveClock());
+}
+
+TEST(PositionHistory, RepetitionShouldRequireSameSideToMove) {
+    PositionHistory history{1};
+    history.push(1, false);
+    EXPECT_EQ(0, history.repetitions());
+    history.push(1, false);
+    EXPECT_EQ(1, history.repetitions());
+}
+
+TEST(PositionHistory, FiftyMoveRuleShouldCountPlies) {
+    PositionHistory history{0, 90};
+    for (std::uint64_t i = 1; i < 10; i++) {
+        history.push(i, false);
+    }
+    EXPECT_FALSE(history.isFiftyMoveDraw());
+    history.push(10, false);
+    EXPECT_TRUE(history.isFiftyMoveDraw());
+    history.push(11, true);
+    EXPECT_FALSE(history.isFiftyMoveDraw());
+}
+
+TEST(PositionHistory, PopShouldRestorePreviousPosition) {
+    PositionHistory history{1};
+    history.push(2, true);
+    history.push(1, false);
+    history.pop();
+    EXPECT_EQ(2, history.size());
+    EXPECT_EQ(0, history.halfmoveClock());
+    history.pop();
+    EXPECT_THROW(history.pop(), std::out_of_range);
+}
+
+TEST(PositionHistory, LongHistoryShouldWrapAround) {
+    PositionHistory history{0};
+    for (std::uint64_t i = 1; i < 3 * PositionHistory::capacity; i++) {
+        history.push(i % 4, false);
+    }
+    EXPECT_EQ(3 * PositionHistory::capacity, history.size());
+    // The position repeats every four plies, but only the last capacity positions are kept.
+    EXPECT_EQ((PositionHistory::capacity - 1) / 4, history.repetitions());
+    for (std::size_t i = 1; i < PositionHistory::capacity; i++) {
+        history.pop();
+    }
+    EXPECT_THROW(history.pop(), std::out_of_range);
+}
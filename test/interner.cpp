@@ -0,0 +1,89 @@
+//
+// Created by taylor-santos on 10/18/2026 at 12:40.
+//
+
+#include "gtest/gtest.h"
+#include "interner.h"
+
+#include <thread>
+
+#include "board.h"
+#include "coord.h"
+#include "piece.h"
+
+using namespace Chess;
+
+static std::shared_ptr<const Board>
+makeBoard(Coord coord, Piece piece) {
+    std::vector<std::pair<Coord, incomplete_ptr<Piece>>> pieces;
+    pieces.emplace_back(coord, std::make_unique<Piece>(piece));
+    return Board::make(std::move(pieces));
+}
+
+TEST(BoardInterner, EqualBoardsShouldShareCanonicalBoard) {
+    Piece         piece{Type::Bishop, Color::White};
+    BoardInterner interner;
+
+    auto board1 = makeBoard({A, _1}, piece)->movePiece({A, _1}, {C, _3});
+    auto board2 = makeBoard({A, _1}, piece);
+    board2      = board2->movePiece({A, _1}, {B, _2})->movePiece({B, _2}, {C, _3});
+
+    auto canonical1 = interner.intern(*board1);
+    auto canonical2 = interner.intern(*board2);
+    EXPECT_EQ(canonical1, canonical2);
+    EXPECT_EQ(*canonical1, *board1);
+    EXPECT_EQ(1, interner.size());
+}
+
+TEST(BoardInterner, DifferentBoardsShouldNotShareCanonicalBoard) {
+    BoardInterner interner;
+
+    auto canonical1 = interner.intern(*makeBoard({A, _1}, {Type::Bishop, Color::White}));
+    auto canonical2 = interner.intern(*makeBoard({A, _1}, {Type::Bishop, Color::Black}));
+    EXPECT_NE(canonical1, canonical2);
+    EXPECT_EQ(2, interner.size());
+}
+
+TEST(BoardInterner, CanonicalBoardShouldHaveNoHistory) {
+    BoardInterner interner;
+
+    auto board     = makeBoard({A, _1}, {Type::Queen, Color::White});
+    auto moved     = board->movePiece({A, _1}, {D, _4})->movePiece({D, _4}, {D, _5});
+    auto canonical = interner.intern(*moved);
+    EXPECT_EQ(canonical->historyBytes(), board->historyBytes());
+}
+
+TEST(BoardInterner, PruneShouldRemoveUnreferencedBoards) {
+    BoardInterner interner;
+
+    auto kept = interner.intern(*makeBoard({A, _1}, {Type::Rook, Color::White}));
+    (void)interner.intern(*makeBoard({B, _1}, {Type::Rook, Color::White}));
+    EXPECT_EQ(2, interner.size());
+    EXPECT_EQ(1, interner.prune());
+    EXPECT_EQ(1, interner.size());
+    EXPECT_EQ(kept, interner.intern(*makeBoard({A, _1}, {Type::Rook, Color::White})));
+}
+
+TEST(BoardInterner, ConcurrentInternShouldAgree) {
+    BoardInterner interner{4};
+
+    constexpr int                             threadCount = 8;
+    std::vector<std::shared_ptr<const Board>> results(threadCount);
+    std::vector<std::thread>                  threads;
+    for (int i = 0; i < threadCount; i++) {
+        threads.emplace_back([&, i] {
+            auto board = makeBoard({A, _1}, {Type::King, Color::Black});
+            for (int j = 0; j <= i; j++) {
+                board = board->movePiece({A, _1}, {A, _2})->movePiece({A, _2}, {A, _1});
+            }
+            results[i] = interner.intern(*board);
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    for (auto &result : results) {
+        EXPECT_EQ(results.front(), result);
+    }
+    EXPECT_EQ(1, interner.size());
+}
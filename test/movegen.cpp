@@ -0,0 +1,164 @@
+//
+// Created by taylor-santos on 10/18/2026 at 17:35.
+//
+
+#include "gtest/gtest.h"
+#include "movegen.h"
+
+#include <algorithm>
+#include <random>
+
+#include "board.h"
+#include "boards.h"
+
+using namespace Chess;
+
+static bool
+contains(const std::vector<Move> &moves, const Move &move) {
+    return std::find(moves.begin(), moves.end(), move) != moves.end();
+}
+
+TEST(MoveGen, PawnShouldPushCaptureAndPromote) {
+    AttackMap map{*makeBoard({
+        {{B, _2}, {Type::Pawn, Color::White}},
+        {{C, _3}, {Type::Knight, Color::Black}},
+        {{G, _7}, {Type::Pawn, Color::White}},
+    })};
+    auto moves = pseudoLegalMoves(map, Color::White);
+    EXPECT_TRUE(contains(moves, {{B, _2}, {B, _3}, std::nullopt}));
+    EXPECT_TRUE(contains(moves, {{B, _2}, {B, _4}, std::nullopt}));
+    EXPECT_TRUE(contains(moves, {{B, _2}, {C, _3}, std::nullopt}));
+    EXPECT_FALSE(contains(moves, {{B, _2}, {A, _3}, std::nullopt}));
+    EXPECT_TRUE(contains(moves, {{G, _7}, {G, _8}, Type::Queen}));
+    EXPECT_TRUE(contains(moves, {{G, _7}, {G, _8}, Type::Knight}));
+    EXPECT_FALSE(contains(moves, {{G, _7}, {G, _8}, std::nullopt}));
+}
+
+TEST(MoveGen, PortalsShouldNotMove) {
+    AttackMap map{*makeBoard({
+        {{D, _4}, {Type::Portal, Color::White}},
+        {{F, _6}, {Type::Portal, Color::White}},
+    })};
+    EXPECT_TRUE(pseudoLegalMoves(map, Color::White).empty());
+}
+
+TEST(MoveGen, PinnedPieceShouldOnlyMoveAlongPin) {
+    AttackMap map{*makeBoard({
+        {{E, _1}, {Type::King, Color::White}},
+        {{E, _2}, {Type::Rook, Color::White}},
+        {{E, _8}, {Type::Rook, Color::Black}},
+    })};
+    auto moves = legalMoves(map, Color::White);
+    EXPECT_TRUE(contains(moves, {{E, _2}, {E, _5}, std::nullopt}));
+    EXPECT_TRUE(contains(moves, {{E, _2}, {E, _8}, std::nullopt}));
+    EXPECT_FALSE(contains(moves, {{E, _2}, {D, _2}, std::nullopt}));
+}
+
+TEST(MoveGen, PinThroughPortalShouldBeDetected) {
+    // The ray from the king at A4 enters the portal at D4 and continues from F6 towards H6.
+    AttackMap map{*makeBoard({
+        {{A, _4}, {Type::King, Color::White}},
+        {{D, _4}, {Type::Portal, Color::Black}},
+        {{F, _6}, {Type::Portal, Color::Black}},
+        {{G, _6}, {Type::Knight, Color::White}},
+        {{H, _6}, {Type::Rook, Color::Black}},
+    })};
+    LegalityMasks masks{map, Color::White};
+    EXPECT_FALSE(masks.inCheck());
+    EXPECT_FALSE(masks.isLegal({{G, _6}, {E, _5}, std::nullopt}));
+    auto moves = legalMoves(map, Color::White);
+    EXPECT_TRUE(std::none_of(moves.begin(), moves.end(), [](const Move &move) {
+        return move.from == Coord{G, _6};
+    }));
+}
+
+TEST(MoveGen, CheckThroughPortalShouldBeDetected) {
+    AttackMap map{*makeBoard({
+        {{A, _4}, {Type::King, Color::White}},
+        {{D, _4}, {Type::Portal, Color::Black}},
+        {{F, _6}, {Type::Portal, Color::Black}},
+        {{H, _6}, {Type::Rook, Color::Black}},
+        {{B, _1}, {Type::Rook, Color::White}},
+    })};
+    LegalityMasks masks{map, Color::White};
+    EXPECT_TRUE(masks.inCheck());
+    EXPECT_TRUE(inCheck(map, Color::White));
+    // Blocking on either side of the portal is legal, moving elsewhere is not.
+    EXPECT_TRUE(masks.isLegal({{B, _1}, {B, _4}, std::nullopt}));
+    EXPECT_FALSE(masks.isLegal({{B, _1}, {B, _2}, std::nullopt}));
+}
+
+TEST(MoveGen, KingShouldNotRetreatAlongCheckingRay) {
+    AttackMap map{*makeBoard({
+        {{D, _1}, {Type::King, Color::White}},
+        {{H, _1}, {Type::Rook, Color::Black}},
+    })};
+    auto moves = legalMoves(map, Color::White);
+    EXPECT_FALSE(contains(moves, {{D, _1}, {C, _1}, std::nullopt}));
+    EXPECT_FALSE(contains(moves, {{D, _1}, {E, _1}, std::nullopt}));
+    EXPECT_TRUE(contains(moves, {{D, _1}, {D, _2}, std::nullopt}));
+}
+
+TEST(MoveGen, DoubleCheckShouldOnlyAllowKingMoves) {
+    AttackMap map{*makeBoard({
+        {{E, _1}, {Type::King, Color::White}},
+        {{E, _8}, {Type::Rook, Color::Black}},
+        {{F, _3}, {Type::Knight, Color::Black}},
+        {{A, _8}, {Type::Rook, Color::White}},
+    })};
+    auto moves = legalMoves(map, Color::White);
+    ASSERT_FALSE(moves.empty());
+    for (auto &move : moves) {
+        EXPECT_EQ((Coord{E, _1}), move.from) << move;
+    }
+}
+
+TEST(MoveGen, ApplyMoveShouldCaptureAndPromote) {
+    auto board = makeBoard({
+        {{G, _7}, {Type::Pawn, Color::White}},
+        {{H, _8}, {Type::Rook, Color::Black}},
+    });
+    AttackMap map{*board};
+    Move      move{{G, _7}, {H, _8}, Type::Queen};
+    board = applyMove(*board, move);
+    applyMove(map, move);
+    ASSERT_TRUE(board->at({H, _8}));
+    EXPECT_EQ((Piece{Type::Queen, Color::White}), **board->at({H, _8}));
+    EXPECT_EQ((Piece{Type::Queen, Color::White}), *map.at({H, _8}));
+    EXPECT_FALSE(board->at({G, _7}));
+}
+
+TEST(MoveGen, LegalMovesShouldMatchMakeAndTest) {
+    std::mt19937 rng{2021};
+    Type         types[] =
+        {Type::Bishop, Type::Knight, Type::Pawn, Type::Portal, Type::Queen, Type::Rook};
+
+    for (int position = 0; position < 300; position++) {
+        auto board = Board::make({});
+        for (auto color : {Color::White, Color::Black}) {
+            for (;;) {
+                auto coord = coordOf(static_cast<int>(rng() % 64));
+                if (board->at(coord)) continue;
+                board = board->addPiece(coord, std::make_unique<Piece>(Type::King, color));
+                break;
+            }
+        }
+        for (int i = 0; i < 10; i++) {
+            auto coord = coordOf(static_cast<int>(rng() % 64));
+            if (board->at(coord)) continue;
+            auto color = rng() % 2 ? Color::White : Color::Black;
+            board      = board->addPiece(coord, std::make_unique<Piece>(types[rng() % 6], color));
+        }
+
+        AttackMap map{*board};
+        for (auto color : {Color::White, Color::Black}) {
+            auto legal = legalMoves(map, color);
+            for (auto &move : pseudoLegalMoves(map, color)) {
+                auto after = map;
+                applyMove(after, move);
+                ASSERT_EQ(!inCheck(after, color), contains(legal, move))
+                    << "position " << position << " move " << move;
+            }
+        }
+    }
+}
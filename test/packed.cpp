@@ -0,0 +1,122 @@
+//
+// Created by taylor-santos on 10/18/2026 at 22:10.
+//
+
+#include "gtest/gtest.h"
+#include "packed.h"
+
+#include <algorithm>
+#include <random>
+#include <unordered_set>
+
+#include "attacks.h"
+
+using namespace Chess;
+
+static std::shared_ptr<const Board>
+randomBoard(std::mt19937 &rng, int count) {
+    Type types[] = {
+        Type::Bishop,
+        Type::King,
+        Type::Knight,
+        Type::Pawn,
+        Type::Portal,
+        Type::Queen,
+        Type::Rook};
+    auto board = Board::make({});
+    for (int i = 0; i < count; i++) {
+        auto coord = coordOf(static_cast<int>(rng() % 64));
+        if (board->at(coord)) continue;
+        auto color = rng() % 2 ? Color::White : Color::Black;
+        board      = board->addPiece(coord, std::make_unique<Piece>(types[rng() % 7], color));
+    }
+    return board;
+}
+
+TEST(PackedBoard, EmptyBoardIsAllZero) {
+    PackedBoard packed;
+    for (auto byte : packed.data()) {
+        EXPECT_EQ(0, byte);
+    }
+    EXPECT_EQ(packed, PackedBoard{*Board::make({})});
+}
+
+TEST(PackedBoard, SquaresArePackedAsNibbles) {
+    auto board = Board::make({});
+    board      = board->addPiece({A, _1}, std::make_unique<Piece>(Type::Bishop, Color::White));
+    board      = board->addPiece({B, _1}, std::make_unique<Piece>(Type::Rook, Color::Black));
+    board      = board->addPiece({H, _8}, std::make_unique<Piece>(Type::Portal, Color::White));
+
+    PackedBoard packed{*board};
+    EXPECT_EQ(0xE1, packed.data()[0]);
+    EXPECT_EQ(0x90, packed.data()[31]);
+    EXPECT_EQ((Piece{Type::Rook, Color::Black}), *packed.at({B, _1}));
+    EXPECT_FALSE(packed.at({C, _1}));
+}
+
+TEST(PackedBoard, RoundTripsThroughBoard) {
+    std::mt19937 rng{2035};
+    for (int trial = 0; trial < 200; trial++) {
+        auto        board = randomBoard(rng, static_cast<int>(rng() % 64));
+        PackedBoard packed{*board};
+        auto        unpacked = packed.unpack();
+        EXPECT_EQ(*board, *unpacked);
+        EXPECT_EQ(board->hash(), unpacked->hash());
+        EXPECT_EQ(packed, PackedBoard{*unpacked});
+        for (int square = 0; square < 64; square++) {
+            auto coord = coordOf(square);
+            auto piece = board->at(coord);
+            ASSERT_EQ(piece.has_value(), packed.at(coord).has_value());
+            if (piece) {
+                EXPECT_EQ(**piece, *packed.at(coord));
+            }
+        }
+    }
+}
+
+TEST(PackedBoard, EqualityAndHashIgnoreHistory) {
+    auto board = Board::make({});
+    board      = board->addPiece({C, _3}, std::make_unique<Piece>(Type::Knight, Color::White));
+    auto moved = board->movePiece({C, _3}, {E, _4})->movePiece({E, _4}, {C, _3});
+
+    EXPECT_EQ(PackedBoard{*board}, PackedBoard{*moved});
+    EXPECT_EQ(PackedBoard{*board}.hash(), PackedBoard{*moved}.hash());
+    EXPECT_NE(PackedBoard{*board}, PackedBoard{*Board::make({})});
+}
+
+TEST(PackedBoard, OrderMatchesBytewiseComparison) {
+    std::mt19937             rng{35};
+    std::vector<PackedBoard> boards;
+    for (int trial = 0; trial < 100; trial++) {
+        boards.emplace_back(*randomBoard(rng, static_cast<int>(rng() % 8)));
+    }
+    boards.emplace_back(boards.front());
+
+    for (auto &a : boards) {
+        for (auto &b : boards) {
+            auto expected = std::lexicographical_compare(
+                a.data().begin(),
+                a.data().end(),
+                b.data().begin(),
+                b.data().end());
+            ASSERT_EQ(expected, a < b);
+            ASSERT_EQ(a.data() == b.data(), a == b);
+        }
+    }
+}
+
+TEST(PackedBoard, WorksInUnorderedSet) {
+    std::mt19937                    rng{3500};
+    std::unordered_set<PackedBoard> seen;
+    std::vector<PackedBoard>        boards;
+    for (int trial = 0; trial < 500; trial++) {
+        boards.emplace_back(*randomBoard(rng, 3));
+        seen.insert(boards.back());
+    }
+    for (auto &board : boards) {
+        EXPECT_EQ(1, seen.count(board));
+    }
+    std::sort(boards.begin(), boards.end());
+    auto unique = std::unique(boards.begin(), boards.end()) - boards.begin();
+    EXPECT_EQ(seen.size(), static_cast<std::size_t>(unique));
+}
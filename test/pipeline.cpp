@@ -0,0 +1,160 @@
+//
+// Created by taylor-santos on 10/19/2026 at 01:52.
+//
+
+#include "gtest/gtest.h"
+#include "pipeline.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+using namespace Chess;
+
+static SearchLimits
+limits(int depth) {
+    SearchLimits limits;
+    limits.depth = depth;
+    return limits;
+}
+
+TEST(ThreadPool, RunsEveryTask) {
+    std::atomic<int> count{0};
+    {
+        ThreadPool pool{4};
+        EXPECT_EQ(4U, pool.size());
+        for (int i = 0; i < 1000; i++) {
+            pool.submit([&] { count++; });
+        }
+    }
+    EXPECT_EQ(1000, count);
+}
+
+TEST(ThreadPool, RunsTasksSubmittedByTasks) {
+    std::atomic<int> count{0};
+    {
+        ThreadPool pool{3};
+        for (int i = 0; i < 10; i++) {
+            pool.submit([&] {
+                for (int j = 0; j < 10; j++) {
+                    pool.submit([&] { count++; });
+                }
+            });
+        }
+    }
+    EXPECT_EQ(100, count);
+}
+
+TEST(ThreadPool, StartsSubmittedTasksInOrder) {
+    std::atomic<bool> release{false};
+    std::vector<int>  order;
+    {
+        ThreadPool pool{1};
+        pool.submit([&] {
+            while (!release) std::this_thread::yield();
+        });
+        for (int i = 0; i < 100; i++) {
+            pool.submit([&order, i] { order.push_back(i); });
+        }
+        release = true;
+    }
+    ASSERT_EQ(100U, order.size());
+    EXPECT_TRUE(std::is_sorted(order.begin(), order.end()));
+}
+
+TEST(ThreadPool, RejectsZeroThreads) {
+    EXPECT_THROW(ThreadPool{0}, std::invalid_argument);
+}
+
+TEST(ReorderBuffer, ReleasesInReservedOrder) {
+    ReorderBuffer<int> buffer{4};
+    auto               a = buffer.reserve();
+    auto               b = buffer.reserve();
+    auto               c = buffer.reserve();
+    buffer.complete(c, 30);
+    buffer.complete(a, 10);
+    buffer.complete(b, 20);
+    buffer.close();
+    EXPECT_EQ(10, buffer.next());
+    EXPECT_EQ(20, buffer.next());
+    EXPECT_EQ(30, buffer.next());
+    EXPECT_FALSE(buffer.next());
+    EXPECT_THROW((void)buffer.reserve(), std::logic_error);
+}
+
+TEST(ReorderBuffer, ReserveBlocksWhileFull) {
+    ReorderBuffer<int> buffer{2};
+    buffer.complete(buffer.reserve(), 1);
+    buffer.complete(buffer.reserve(), 2);
+
+    std::atomic<bool> reserved{false};
+    std::thread       producer{[&] {
+        buffer.complete(buffer.reserve(), 3);
+        reserved = true;
+    }};
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_FALSE(reserved);
+
+    EXPECT_EQ(1, buffer.next());
+    producer.join();
+    EXPECT_TRUE(reserved);
+    buffer.close();
+    EXPECT_EQ(2, buffer.next());
+    EXPECT_EQ(3, buffer.next());
+    EXPECT_FALSE(buffer.next());
+}
+
+TEST(Pipeline, AnalyzeLine) {
+    Search search;
+    auto   mate = analyzeLine("6k1/5ppp/8/8/8/8/8/R5K1 w", search, limits(3));
+    EXPECT_EQ(0U, mate.rfind("bestmove A1A8 score mate 1 depth 2 nodes ", 0)) << mate;
+    EXPECT_EQ(
+        "bestmove none score mate 0 depth 0 nodes 0",
+        analyzeLine("R5k1/5ppp/8/8/8/8/8/6K1 b", search, limits(3)));
+    EXPECT_EQ(0U, analyzeLine("8/8 w", search, limits(3)).rfind("error ", 0));
+}
+
+TEST(Pipeline, AnalyzeKeepsInputOrder) {
+    const char *games[] = {
+        "6k1/5ppp/8/8/8/8/8/R5K1 w",
+        "4k3/8/8/3q4/8/8/8/3RK3 w",
+        "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w moves E2E4 E7E5",
+        "not a position",
+        "4k3/8/8/8/8/8/4P3/4K3 w moves E2E4 E8D7",
+    };
+    AnalysisOptions options;
+    options.limits       = limits(2);
+    options.threads      = 4;
+    options.window       = 3;
+    options.tableEntries = 1024;
+
+    std::stringstream in, expected;
+    for (int i = 0; i < 20; i++) {
+        for (auto game : games) {
+            Search search{options.tableEntries};
+            in << game << '\n';
+            expected << game << '\t' << analyzeLine(game, search, options.limits) << '\n';
+        }
+        in << "# comment\n\n";
+    }
+
+    std::stringstream out;
+    EXPECT_EQ(100U, analyze(in, out, options));
+    EXPECT_EQ(expected.str(), out.str());
+}
+
+TEST(Pipeline, AnalyzeRejectsEmptyOptions) {
+    std::stringstream in{"6k1/5ppp/8/8/8/8/8/R5K1 w\n"}, out;
+    AnalysisOptions   options;
+    options.limits = limits(1);
+
+    options.threads = 0;
+    EXPECT_THROW(analyze(in, out, options), std::invalid_argument);
+    options.threads = 1;
+    options.window  = 0;
+    EXPECT_THROW(analyze(in, out, options), std::invalid_argument);
+    EXPECT_TRUE(out.str().empty());
+}
@@ -0,0 +1,57 @@
+//
+// Created by taylor-santos on 10/19/2026 at 01:34.
+//
+
+#include "gtest/gtest.h"
+#include "position.h"
+
+#include <stdexcept>
+
+using namespace Chess;
+
+TEST(Position, ParsePlacesPieces) {
+    auto position = parsePosition("4k3/8/8/3o4/8/8/4P3/O3K3 b");
+    EXPECT_EQ(Color::Black, position.toMove);
+    EXPECT_EQ((Piece{Type::King, Color::Black}), *position.board.at({File::E, Rank::_8}));
+    EXPECT_EQ((Piece{Type::Portal, Color::Black}), *position.board.at({File::D, Rank::_5}));
+    EXPECT_EQ((Piece{Type::Pawn, Color::White}), *position.board.at({File::E, Rank::_2}));
+    EXPECT_EQ((Piece{Type::Portal, Color::White}), *position.board.at({File::A, Rank::_1}));
+    EXPECT_EQ((Piece{Type::King, Color::White}), *position.board.at({File::E, Rank::_1}));
+    EXPECT_FALSE(position.board.at({File::A, Rank::_8}));
+}
+
+TEST(Position, FormatRoundTrips) {
+    for (auto text : {
+             "4k3/8/8/3o4/8/8/4P3/O3K3 w",
+             "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR b"}) {
+        EXPECT_EQ(text, formatPosition(parsePosition(text)));
+    }
+}
+
+TEST(Position, ParseRejectsMalformedPositions) {
+    EXPECT_THROW((void)parsePosition(""), std::invalid_argument);
+    EXPECT_THROW((void)parsePosition("8/8/8/8/8/8/8/8"), std::invalid_argument);
+    EXPECT_THROW((void)parsePosition("8/8/8/8/8/8/8 w"), std::invalid_argument);
+    EXPECT_THROW((void)parsePosition("9/8/8/8/8/8/8/8 w"), std::invalid_argument);
+    EXPECT_THROW((void)parsePosition("7x/8/8/8/8/8/8/8 w"), std::invalid_argument);
+    EXPECT_THROW((void)parsePosition("8/8/8/8/8/8/8/8 x"), std::invalid_argument);
+}
+
+TEST(Position, ParseMove) {
+    EXPECT_EQ((Move{{File::E, Rank::_2}, {File::E, Rank::_4}, {}}), parseMove("E2E4"));
+    EXPECT_EQ((Move{{File::B, Rank::_7}, {File::B, Rank::_8}, Type::Queen}), parseMove("B7B8=Q"));
+    EXPECT_THROW((void)parseMove("E2"), std::invalid_argument);
+    EXPECT_THROW((void)parseMove("E9E4"), std::invalid_argument);
+    EXPECT_THROW((void)parseMove("B7B8=X"), std::invalid_argument);
+}
+
+TEST(Position, ParseGameAppliesMoves) {
+    auto position = parseGame("4k3/8/8/8/8/8/4P3/4K3 w moves E2E4 E8D7");
+    EXPECT_EQ("8/3k4/8/8/4P3/8/8/4K3 w", formatPosition(position));
+}
+
+TEST(Position, ParseGameRejectsIllegalMoves) {
+    EXPECT_THROW((void)parseGame("4k3/8/8/8/8/8/4P3/4K3 w moves E2E5"), std::invalid_argument);
+    EXPECT_THROW((void)parseGame("4k3/8/8/8/8/8/4P3/4K3 w moves E8D7"), std::invalid_argument);
+    EXPECT_THROW((void)parseGame("4k3/8/8/8/8/8/4P3/4K3 w E2E4"), std::invalid_argument);
+}
@@ -0,0 +1,253 @@
+//
+// Created by taylor-santos on 10/19/2026 at 01:41.
+//
+
+#include "gtest/gtest.h"
+#include "search.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+#include "position.h"
+#include "stats.h"
+
+using namespace Chess;
+using namespace std::chrono_literals;
+
+static const char *const middlegame = "r3k2r/ppp2ppp/2n5/3qp3/3P4/2N2N2/PPP2PPP/R2QK2R w";
+
+static SearchLimits
+limits(int depth, std::uint64_t nodes = 0) {
+    SearchLimits limits;
+    limits.depth = depth;
+    limits.nodes = nodes;
+    return limits;
+}
+
+static SearchLimits
+timed(std::chrono::milliseconds remaining) {
+    SearchLimits limits;
+    limits.clock            = TimeControl{};
+    limits.clock->remaining = remaining;
+    return limits;
+}
+
+static AttackMap
+mapOf(const char *text) {
+    auto board = parsePosition(text).board.unpack();
+    return AttackMap{*board};
+}
+
+static SearchResult
+searchPosition(const char *text, SearchLimits limits) {
+    auto      position = parsePosition(text);
+    auto      board    = position.board.unpack();
+    AttackMap map{*board};
+    Search    search;
+    return search.run(map, position.toMove, limits);
+}
+
+TEST(Search, FindsMateInOne) {
+    auto result = searchPosition("6k1/5ppp/8/8/8/8/8/R5K1 w", limits(3));
+    ASSERT_TRUE(result.bestMove);
+    EXPECT_EQ((Move{{File::A, Rank::_1}, {File::A, Rank::_8}, {}}), *result.bestMove);
+    EXPECT_EQ(Search::mateScore - 1, result.score);
+}
+
+TEST(Search, CapturesHangingQueen) {
+    auto result = searchPosition("4k3/8/8/3q4/8/8/8/3RK3 w", limits(2));
+    ASSERT_TRUE(result.bestMove);
+    EXPECT_EQ((Move{{File::D, Rank::_1}, {File::D, Rank::_5}, {}}), *result.bestMove);
+    EXPECT_GT(result.score, 0);
+}
+
+TEST(Search, ReportsCheckmateAndStalemate) {
+    auto mated = searchPosition("R5k1/5ppp/8/8/8/8/8/6K1 b", {});
+    EXPECT_FALSE(mated.bestMove);
+    EXPECT_EQ(-Search::mateScore, mated.score);
+
+    auto stalemated = searchPosition("7k/5Q2/6K1/8/8/8/8/8 b", {});
+    EXPECT_FALSE(stalemated.bestMove);
+    EXPECT_EQ(0, stalemated.score);
+}
+
+TEST(Search, RespectsNodeLimit) {
+    auto text   = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w";
+    auto result = searchPosition(text, limits(64, 500));
+    EXPECT_LE(result.nodes, 500U);
+    EXPECT_LT(result.depth, 64);
+    EXPECT_TRUE(result.bestMove);
+}
+
+TEST(Search, IsDeterministic) {
+    auto first = searchPosition(middlegame, limits(3));
+    auto again = searchPosition(middlegame, limits(3));
+    EXPECT_EQ(first.bestMove, again.bestMove);
+    EXPECT_EQ(first.score, again.score);
+    EXPECT_EQ(first.nodes, again.nodes);
+}
+
+TEST(Search, EvaluateIsSymmetric) {
+    auto position = parsePosition("4k3/3ppp2/8/8/8/8/3PPP2/4K3 w");
+    auto board    = position.board.unpack();
+    AttackMap map{*board};
+    EXPECT_EQ(0, evaluate(map, Color::White));
+    EXPECT_EQ(0, evaluate(map, Color::Black));
+}
+
+TEST(Search, ReportsPonderMove) {
+    auto map    = mapOf("4k3/8/8/3q4/8/8/8/3RK3 w");
+    auto result = Search{}.run(map, Color::White, limits(3));
+    ASSERT_TRUE(result.bestMove);
+    ASSERT_TRUE(result.ponderMove);
+
+    applyMove(map, *result.bestMove);
+    auto replies = legalMoves(map, Color::Black);
+    EXPECT_NE(replies.end(), std::find(replies.begin(), replies.end(), *result.ponderMove));
+}
+
+TEST(Search, TimedSearchStaysWithinMaximum) {
+    auto        map   = mapOf(middlegame);
+    auto        limit = timed(3s);
+    TimeManager budget{*limit.clock};
+    Search      search;
+
+    auto start  = std::chrono::steady_clock::now();
+    auto result = search.run(map, Color::White, limit);
+    auto spent  = std::chrono::steady_clock::now() - start;
+    EXPECT_TRUE(result.bestMove);
+    EXPECT_GE(result.depth, 1);
+    // The clock is only checked every 1024 nodes, and a loaded machine may not schedule the search
+    // promptly, so only check that the search does not run for anywhere near its full depth. The
+    // time budget itself is tested exactly in timeman.cpp.
+    EXPECT_LT(spent, budget.maximum() + 2s);
+}
+
+TEST(Search, PlaysForcedMoveAfterOneIteration) {
+    auto map    = mapOf("8/8/8/8/8/2k5/2r5/K7 w");
+    auto result = Search{}.run(map, Color::White, timed(60s));
+    EXPECT_EQ(1, result.depth);
+    EXPECT_EQ((Move{{File::A, Rank::_1}, {File::B, Rank::_1}, {}}), result.bestMove);
+}
+
+TEST(Search, PonderIgnoresClockUntilPonderHit) {
+    auto   map   = mapOf(middlegame);
+    auto   limit = timed(100ms);
+    Search search;
+    limit.ponder = true;
+
+    std::atomic<bool> done{false};
+    SearchResult      result;
+    std::thread       thread{[&] {
+        result = search.run(map, Color::White, limit);
+        done   = true;
+    }};
+    // The clock allows about 10 ms, but it is the opponent's time that is being used.
+    std::this_thread::sleep_for(200ms);
+    EXPECT_FALSE(done);
+
+    auto hit = std::chrono::steady_clock::now();
+    search.ponderHit();
+    thread.join();
+    // The clock has run out by now, so the search stops at its next clock check; the generous
+    // margin only allows for a loaded machine.
+    EXPECT_LT(std::chrono::steady_clock::now() - hit, 2s);
+    EXPECT_TRUE(result.bestMove);
+    EXPECT_GE(result.depth, 2);
+}
+
+TEST(Search, StopEndsPonderSearch) {
+    auto         map = mapOf(middlegame);
+    SearchLimits limit;
+    Search       search;
+    limit.ponder = true;
+
+    // A stop() made before the search thread even starts must not be lost.
+    search.arm();
+    search.stop();
+    SearchResult result;
+    std::thread  thread{[&] { result = search.run(map, Color::White, limit); }};
+    thread.join();
+    EXPECT_TRUE(result.bestMove);
+    EXPECT_EQ(0, result.depth);
+
+    // Until the next arm(), every search returns at once.
+    EXPECT_EQ(0, search.run(map, Color::White, limits(3)).depth);
+    search.arm();
+    EXPECT_EQ(3, search.run(map, Color::White, limits(3)).depth);
+}
+
+TEST(Search, PonderWaitsAtDepthLimit) {
+    auto   map   = mapOf("6k1/5ppp/8/8/8/8/8/R5K1 w");
+    auto   limit = limits(2);
+    Search search;
+    limit.ponder = true;
+
+    std::atomic<bool> done{false};
+    SearchResult      result;
+    std::thread       thread{[&] {
+        result = search.run(map, Color::White, limit);
+        done   = true;
+    }};
+    // The mate is found at once, but the search must wait for the opponent's move.
+    std::this_thread::sleep_for(100ms);
+    EXPECT_FALSE(done);
+
+    search.ponderHit();
+    thread.join();
+    EXPECT_EQ(Search::mateScore - 1, result.score);
+    EXPECT_EQ((Move{{File::A, Rank::_1}, {File::A, Rank::_8}, {}}), result.bestMove);
+}
+
+TEST(Search, ReusesTableBetweenRuns) {
+    auto map = mapOf(middlegame);
+
+    // A ponder search that reaches its depth limit fills the table like any other. Without a
+    // clock, when the ponderHit() lands does not change the result.
+    auto         ponder = limits(4);
+    Search       search;
+    SearchResult first;
+    ponder.ponder = true;
+    std::thread thread{[&] { first = search.run(map, Color::White, ponder); }};
+    search.ponderHit();
+    thread.join();
+    auto again = search.run(map, Color::White, limits(4));
+    EXPECT_EQ(4, again.depth);
+    EXPECT_LT(again.nodes * 2, first.nodes);
+
+    search.clear();
+    auto cleared = search.run(map, Color::White, limits(4));
+    EXPECT_EQ(first.nodes, cleared.nodes);
+    EXPECT_EQ(first.bestMove, cleared.bestMove);
+}
+
+TEST(Search, CountsNodes) {
+    if (!Stats::enabled) GTEST_SKIP() << "instrumentation is disabled";
+    Stats::reset();
+    auto result = searchPosition("4k3/8/8/3q4/8/8/8/3RK3 w", limits(2));
+    auto snap   = Stats::snapshot();
+    EXPECT_EQ(result.nodes, snap[Stats::Counter::SearchNodes]);
+    EXPECT_EQ(1, snap[Stats::Timer::Search].calls);
+}
+
+TEST(Search, TimerExcludesPonderWait) {
+    if (!Stats::enabled) GTEST_SKIP() << "instrumentation is disabled";
+    auto   map   = mapOf("6k1/5ppp/8/8/8/8/8/R5K1 w");
+    auto   limit = limits(2);
+    Search search;
+    limit.ponder = true;
+
+    Stats::reset();
+    SearchResult result;
+    std::thread  thread{[&] { result = search.run(map, Color::White, limit); }};
+    std::this_thread::sleep_for(500ms);
+    search.ponderHit();
+    thread.join();
+    EXPECT_EQ(Search::mateScore - 1, result.score);
+
+    // The mate is found at once; the half second spent waiting must not count as search time.
+    auto timer = Stats::snapshot()[Stats::Timer::Search];
+    EXPECT_EQ(1, timer.calls);
+    EXPECT_LT(timer.nanos, std::chrono::nanoseconds{500ms}.count());
+}
@@ -0,0 +1,79 @@
+//
+// Created by taylor-santos on 10/18/2026 at 10:31.
+//
+
+#include "gtest/gtest.h"
+#include "stats.h"
+
+#include <sstream>
+#include <thread>
+
+#include "board.h"
+#include "coord.h"
+#include "piece.h"
+
+using namespace Chess;
+
+TEST(Stats, SnapshotIsEmptyWhenDisabled) {
+    if (Stats::enabled) GTEST_SKIP() << "instrumentation is enabled";
+    auto board = Board::make({});
+    board      = board->addPiece({A, _1}, std::make_unique<Piece>(Type::Rook, Color::White));
+    auto snap  = Stats::snapshot();
+    for (auto value : snap.counters) {
+        EXPECT_EQ(0, value);
+    }
+}
+
+TEST(Stats, BoardOperationsAreCounted) {
+    if (!Stats::enabled) GTEST_SKIP() << "instrumentation is disabled";
+    Stats::reset();
+    auto board = Board::make({});
+    board      = board->addPiece({A, _1}, std::make_unique<Piece>(Type::Rook, Color::White));
+    board      = board->movePiece({A, _1}, {A, _2});
+    board      = board->movePiece({A, _2}, {A, _3});
+    (void)board->at({A, _3});
+
+    auto snap = Stats::snapshot();
+    EXPECT_EQ(4, snap[Stats::Counter::BoardNodes]);
+    EXPECT_EQ(4, snap[Stats::Counter::Allocations]);
+    EXPECT_GT(snap[Stats::Counter::AllocatedBytes], 0);
+    // The lookup at A3 walks MovedPiece -> MovedPiece -> AddedPiece.
+    EXPECT_GE(snap[Stats::Gauge::AtMaxDepth], 3);
+    EXPECT_GT(snap[Stats::Counter::AtCalls], 0);
+}
+
+TEST(Stats, InvalidPieceIsCounted) {
+    if (!Stats::enabled) GTEST_SKIP() << "instrumentation is disabled";
+    Stats::reset();
+    auto board = Board::make({});
+    EXPECT_THROW((void)board->removePiece({A, _1}), invalid_piece);
+    EXPECT_EQ(1, Stats::snapshot()[Stats::Counter::InvalidPiece]);
+}
+
+TEST(Stats, ExitedThreadsAreRetained) {
+    if (!Stats::enabled) GTEST_SKIP() << "instrumentation is disabled";
+    Stats::reset();
+    std::thread worker{[] { Stats::add(Stats::Counter::SearchNodes, 5); }};
+    worker.join();
+    Stats::add(Stats::Counter::SearchNodes, 2);
+    EXPECT_EQ(7, Stats::snapshot()[Stats::Counter::SearchNodes]);
+}
+
+TEST(Stats, NodesPerSecondUsesSearchTimer) {
+    Stats::Snapshot snap;
+    snap.counters[static_cast<std::size_t>(Stats::Counter::SearchNodes)] = 3000;
+    snap.timers[static_cast<std::size_t>(Stats::Timer::Search)]          = {1, 1500000000};
+    EXPECT_DOUBLE_EQ(2000.0, snap.searchNodesPerSecond());
+}
+
+TEST(Stats, JsonContainsEveryCounter) {
+    std::stringstream ss;
+    Stats::dumpJson(ss);
+    auto json = ss.str();
+    EXPECT_EQ('{', json.front());
+    EXPECT_EQ('}', json.back());
+    for (std::size_t i = 0; i < Stats::counterCount; i++) {
+        auto key = std::string{"\""} + Stats::name(static_cast<Stats::Counter>(i)) + "\":";
+        EXPECT_NE(std::string::npos, json.find(key)) << key;
+    }
+}
@@ -0,0 +1,100 @@
+//
+// Created by taylor-santos on 10/19/2026 at 05:20.
+//
+
+#include "gtest/gtest.h"
+#include "timeman.h"
+
+using namespace Chess;
+using namespace std::chrono_literals;
+
+static TimeControl
+timeControl(
+    std::chrono::milliseconds remaining,
+    std::chrono::milliseconds increment,
+    int                       movesToGo) {
+    TimeControl control;
+    control.remaining = remaining;
+    control.increment = increment;
+    control.movesToGo = movesToGo;
+    return control;
+}
+
+static const BasicMove e2e4{12, 28, std::nullopt};
+static const BasicMove d2d4{11, 27, std::nullopt};
+
+TEST(TimeManager, SplitsSuddenDeathClock) {
+    TimeManager timer{timeControl(30s, 0s, 0)};
+    EXPECT_EQ(TimeManager::Duration{29980ms} / 30, timer.optimum());
+    EXPECT_EQ(timer.optimum() * 4, timer.maximum());
+}
+
+TEST(TimeManager, UsesMovesToGoAndIncrement) {
+    TimeManager timer{timeControl(10s, 1s, 10)};
+    EXPECT_EQ(std::chrono::milliseconds{9980} / 10 + 750ms, timer.optimum());
+
+    // The last move before the time control may use most, but not all, of the clock.
+    TimeManager last{timeControl(10s, 0s, 1)};
+    EXPECT_EQ(std::chrono::milliseconds{9980} * 4 / 5, last.optimum());
+    EXPECT_EQ(last.optimum(), last.maximum());
+}
+
+TEST(TimeManager, NearlyEmptyClock) {
+    TimeManager timer{timeControl(10ms, 0s, 0)};
+    EXPECT_EQ(TimeManager::Duration::zero(), timer.maximum());
+    EXPECT_TRUE(timer.shouldStop(0s));
+    EXPECT_TRUE(timer.outOfTime(0s));
+}
+
+TEST(TimeManager, StopsBeforeAnIterationThatWouldNotFinish) {
+    TimeManager timer{timeControl(30s, 0s, 0)};
+    timer.iterationDone(e2e4, 20, 20);
+    EXPECT_DOUBLE_EQ(1, timer.scale());
+    EXPECT_FALSE(timer.shouldStop(timer.optimum() / 2));
+    EXPECT_TRUE(timer.shouldStop(timer.optimum() * 3 / 5));
+    EXPECT_FALSE(timer.outOfTime(timer.optimum()));
+    EXPECT_TRUE(timer.outOfTime(timer.maximum()));
+}
+
+TEST(TimeManager, ForcedMoveStopsImmediately) {
+    TimeManager timer{timeControl(30s, 0s, 0)};
+    timer.iterationDone(e2e4, 0, 1);
+    EXPECT_TRUE(timer.shouldStop(0s));
+}
+
+TEST(TimeManager, UnstableBestMoveExtends) {
+    TimeManager timer{timeControl(30s, 0s, 0)};
+    timer.iterationDone(e2e4, 20, 20);
+    timer.iterationDone(d2d4, 20, 20);
+    EXPECT_DOUBLE_EQ(2, timer.scale());
+    EXPECT_FALSE(timer.shouldStop(timer.optimum()));
+    timer.iterationDone(e2e4, 20, 20);
+    EXPECT_DOUBLE_EQ(2.5, timer.scale());
+
+    // Old changes count for less and less.
+    timer.iterationDone(e2e4, 20, 20);
+    timer.iterationDone(e2e4, 20, 20);
+    EXPECT_DOUBLE_EQ(1.375, timer.scale());
+}
+
+TEST(TimeManager, FailLowExtends) {
+    TimeManager timer{timeControl(30s, 0s, 0)};
+    timer.iterationDone(e2e4, 50, 20);
+    timer.iterationDone(e2e4, 50 - TimeManager::failLowMargin + 1, 20);
+    EXPECT_DOUBLE_EQ(1, timer.scale());
+    timer.iterationDone(e2e4, 0, 20);
+    EXPECT_DOUBLE_EQ(1.5, timer.scale());
+    timer.iterationDone(e2e4, 0, 20);
+    EXPECT_DOUBLE_EQ(1, timer.scale());
+}
+
+TEST(TimeManager, EasyMoveStopsEarly) {
+    TimeManager timer{timeControl(30s, 0s, 0)};
+    for (int i = 0; i < TimeManager::easyMoveIterations; i++) {
+        timer.iterationDone(e2e4, 20, 20);
+        EXPECT_DOUBLE_EQ(1, timer.scale());
+    }
+    timer.iterationDone(e2e4, 20, 20);
+    EXPECT_DOUBLE_EQ(0.5, timer.scale());
+    EXPECT_TRUE(timer.shouldStop(timer.optimum() * 3 / 10));
+}
@@ -0,0 +1,85 @@
+//
+// Created by taylor-santos on 10/19/2026 at 05:34.
+//
+
+#include "gtest/gtest.h"
+#include "transposition.h"
+
+using namespace Chess;
+
+using Bound = TranspositionTable::Bound;
+
+TEST(TranspositionTable, SizeIsRoundedDownToPowerOfTwo) {
+    EXPECT_EQ(1U, TranspositionTable{1}.size());
+    EXPECT_EQ(1024U, TranspositionTable{1500}.size());
+    EXPECT_EQ(2048U, TranspositionTable{2048}.size());
+    EXPECT_THROW(TranspositionTable{0}, std::invalid_argument);
+}
+
+TEST(TranspositionTable, StoresAndProbes) {
+    TranspositionTable table{1024};
+    std::uint64_t      key = 0x123456789ABCDEF0ULL;
+    EXPECT_FALSE(table.probe(key));
+
+    BasicMove promotion{49, 57, Type::Queen};
+    table.store(key, 5, -300, Bound::Lower, promotion);
+    auto hit = table.probe(key);
+    ASSERT_TRUE(hit);
+    EXPECT_EQ(-300, hit->score);
+    EXPECT_EQ(5, hit->depth);
+    EXPECT_EQ(Bound::Lower, hit->bound);
+    EXPECT_EQ(promotion, hit->move);
+
+    // Same slot, different position.
+    EXPECT_FALSE(table.probe(key ^ (std::uint64_t{1} << 40U)));
+
+    table.clear();
+    EXPECT_FALSE(table.probe(key));
+}
+
+TEST(TranspositionTable, ClearSurvivesEpochWraparound) {
+    TranspositionTable table{16};
+    std::uint64_t      key = 7;
+    table.store(key, 3, 10, Bound::Exact, std::nullopt);
+
+    // Enough clears to bring a 16-bit epoch back to the one the entry was stored in.
+    for (int i = 0; i < 65535; i++) {
+        table.clear();
+        ASSERT_FALSE(table.probe(key));
+    }
+    table.store(key, 1, 20, Bound::Upper, std::nullopt);
+    table.clear();
+    EXPECT_FALSE(table.probe(key));
+}
+
+TEST(TranspositionTable, KeepsDeeperEntriesFromCurrentSearch) {
+    TranspositionTable table{16};
+    std::uint64_t      key   = 0xAAAA00000003ULL;
+    std::uint64_t      other = 0xBBBB00000003ULL;
+    BasicMove          move{1, 2, std::nullopt};
+
+    table.store(key, 6, 10, Bound::Exact, move);
+    table.store(other, 2, 20, Bound::Exact, std::nullopt);
+    EXPECT_TRUE(table.probe(key));
+    EXPECT_FALSE(table.probe(other));
+
+    // Entries from an earlier search can always be replaced.
+    table.newSearch();
+    table.store(other, 2, 20, Bound::Upper, std::nullopt);
+    EXPECT_FALSE(table.probe(key));
+    auto hit = table.probe(other);
+    ASSERT_TRUE(hit);
+    EXPECT_FALSE(hit->move);
+}
+
+TEST(TranspositionTable, KeepsMoveWhenNewResultHasNone) {
+    TranspositionTable table{16};
+    std::uint64_t      key = 42;
+    BasicMove          move{8, 16, std::nullopt};
+    table.store(key, 1, 10, Bound::Exact, move);
+    table.store(key, 2, -10, Bound::Upper, std::nullopt);
+    auto hit = table.probe(key);
+    ASSERT_TRUE(hit);
+    EXPECT_EQ(2, hit->depth);
+    EXPECT_EQ(move, hit->move);
+}